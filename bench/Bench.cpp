@@ -0,0 +1,86 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+#include "Clock.hpp"
+
+using std::cout;
+using std::endl;
+
+void Timings::add(double seconds)
+{
+    m_times.insert(std::upper_bound(m_times.begin(), m_times.end(), seconds), seconds);
+}
+
+double Timings::getPercentile(double percent) const
+{
+    return ::getPercentile(m_times, percent);
+}
+
+Timings measure(unsigned runs, const std::function<void()> &function)
+{
+    return measure(runs, []{}, function);
+}
+
+Timings measure(unsigned runs, const std::function<void()> &prepare, const std::function<void()> &function)
+{
+    Timings timings;
+
+    // the progress messages of the measured functions are hidden
+    QuietOutput quiet;
+
+    for(unsigned run = 0; run <= runs; ++run)
+    {
+        prepare();
+
+        const auto start = hrClock::now();
+        function();
+        const std::chrono::duration<double> elapsed = hrClock::now() - start;
+
+        // the first run fills the caches
+        if(run > 0)
+            timings.add(elapsed.count());
+    }
+
+    return timings;
+}
+
+void report(const std::string &name, const Timings &timings, std::size_t size)
+{
+    auto milliseconds = [](double seconds)
+    {
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(seconds < 0.001 ? 4 : 2) << seconds * 1000;
+        return os.str();
+    };
+
+    cout << "  " << std::left << std::setw(40) << name << std::right
+        << " p50 " << std::setw(9) << milliseconds(timings.getPercentile(50))
+        << " p90 " << std::setw(9) << milliseconds(timings.getPercentile(90))
+        << " p99 " << std::setw(9) << milliseconds(timings.getPercentile(99)) << " ms";
+
+    if(size != 0)
+        cout << std::fixed << std::setprecision(2) << std::setw(8) << size / timings.getPercentile(50) / 1e9 << " GB/s";
+
+    cout << endl;
+}
+
+void fail(const std::string &message)
+{
+    std::cerr << "Error: " << message << endl;
+    std::exit(1);
+}
+
+QuietOutput::QuietOutput() :
+    m_buffer(cout.rdbuf(&m_nullBuffer))
+{
+}
+
+QuietOutput::~QuietOutput()
+{
+    cout.rdbuf(m_buffer);
+}
@@ -0,0 +1,81 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "NullBuffer.hpp"
+
+// settings given on the command line, shared by every suite
+struct BenchOptions
+{
+    // number of measured runs of each case
+    unsigned runs {20};
+
+    // size of the heap-like data of the scan and load fixtures, in MiB
+    std::size_t heapSize {256};
+
+    // size of the biggest generated memory of the scaling suite, in GiB
+    std::uint64_t virtualSize {4};
+
+    // number of entries of the bundle fixture, the real bundle holds about that many
+    std::size_t bundleEntryCount {20000};
+
+    // folder where the fixture files are written
+    std::string folder;
+};
+
+// times of the runs of a case, in seconds
+class Timings
+{
+    public:
+        void add(double seconds);
+
+        // 'percent' between 0 and 100, nearest rank
+        double getPercentile(double percent) const;
+
+    private:
+        std::vector<double> m_times;
+};
+
+// runs 'function' once to warm up, then 'runs' times, std::cout being hidden
+Timings measure(unsigned runs, const std::function<void()> &function);
+
+// same as above, 'prepare' being called before each run without being measured
+Timings measure(unsigned runs, const std::function<void()> &prepare, const std::function<void()> &function);
+
+// prints the name of a case and its latency percentiles
+// the throughput is printed too if 'size' is not 0, from the median time
+void report(const std::string &name, const Timings &timings, std::size_t size = 0);
+
+// stops the check of a suite when a result is wrong
+[[noreturn]] void fail(const std::string &message);
+
+// Hides what is written into std::cout while it exists, so that the progress
+// messages of the measured functions don't disturb the timings.
+class QuietOutput
+{
+    public:
+        QuietOutput();
+        ~QuietOutput();
+
+        QuietOutput(const QuietOutput&) = delete;
+        QuietOutput& operator=(const QuietOutput&) = delete;
+
+    private:
+        NullBuffer m_nullBuffer;
+        std::streambuf *m_buffer;
+};
+
+// the suites, see main.cpp
+void runSearchBench(const BenchOptions &options);
+void runScanBench(const BenchOptions &options);
+void runLoadBench(const BenchOptions &options);
+void runScaleBench(const BenchOptions &options);
+void runBundleBench(const BenchOptions &options);
+
+#endif // BENCH_H
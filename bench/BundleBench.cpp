@@ -0,0 +1,43 @@
+#include "Bench.hpp"
+
+#include <memory>
+
+#include "Bundle.hpp"
+#include "Fixtures.hpp"
+
+using std::cout;
+using std::endl;
+
+void runBundleBench(const BenchOptions &options)
+{
+    const std::string bundleName("Bundle_PC.ipk");
+    makeBundle(options.folder + bundleName, options.bundleEntryCount);
+
+    cout << "Bundle benchmark (" << std::dec << options.bundleEntryCount << " entries)" << endl;
+
+    std::unique_ptr<Bundle> bundle;
+
+    report("Bundle::open", measure(options.runs,
+        [&]{ bundle.reset(new Bundle(options.folder, bundleName)); }));
+
+    // the fixture holds the default files
+    bool installed {true};
+
+    report("Bundle::checkTrainingRoom", measure(options.runs,
+        [&]{ installed = bundle->checkTrainingRoom(); }));
+
+    if(installed)
+        fail("the training room is installed in the fixture!");
+
+    report("Bundle::installTrainingRoom", measure(options.runs,
+        [&]{ bundle->installTrainingRoom(true); }));
+
+    if(!bundle->checkTrainingRoom())
+        fail("the training room is not installed!");
+
+    report("Bundle::installTrainingRoom (uninstall)", measure(options.runs,
+        [&]{ bundle->installTrainingRoom(false); }));
+
+    if(bundle->checkTrainingRoom())
+        fail("the training room is still installed!");
+}
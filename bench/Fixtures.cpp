@@ -0,0 +1,140 @@
+#include "Fixtures.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <QFile>
+
+namespace
+{
+    // the files written by 'Bundle::installTrainingRoom'
+    const std::vector<std::string> trainingRoomFiles{
+        "cache/itf_cooked/pc/enginedata/inputs/menu/input_menu_x360.isg.ckd",
+        "cache/itf_cooked/pc/world/home/brick/challenge/challenge_endless.isc.ckd",
+        "cache/itf_cooked/pc/world/home/paintings_and_notifications/painting_levels/textures/challenge/challenge_1.tga.ckd",
+        "cache/itf_cooked/pc/world/home/paintings_and_notifications/painting_levels/textures/challenge/challenge_2.tga.ckd",
+        "cache/itf_cooked/pc/world/home/paintings_and_notifications/painting_levels/textures/challenge/challenge_3.tga.ckd",
+        "cache/itf_cooked/pc/world/home/paintings_and_notifications/painting_levels/textures/challenge/challenge_4.tga.ckd",
+        "cache/itf_cooked/pc/world/home/paintings_and_notifications/painting_levels/textures/challenge/challenge_5.tga.ckd",
+        "cache/itf_cooked/pc/world/home/paintings_and_notifications/painting_challengeendless/animation/painting_challengeendless_a1.tga.ckd",
+        "cache/itf_cooked/pc/world/common/ui/suitcase/animation/suitcase_a1.tga.ckd"};
+
+    // loads a resource the same way as 'Bundle::loadResource'
+    std::vector<char> loadResource(const std::string &filename, bool mod)
+    {
+        const auto name = filename.substr(filename.find_last_of('/') + 1);
+        QFile resource(QString::fromStdString((mod ? ":/mod/" : ":/default/") + name));
+
+        if(!resource.open(QIODevice::ReadOnly))
+        {
+            resource.setFileName(resource.fileName() + "_COMPRESSED");
+            if(!resource.open(QIODevice::ReadOnly))
+                throw std::runtime_error("Missing resource file \"" + name + "\"!");
+        }
+
+        std::vector<char> data(static_cast<std::size_t>(resource.size()));
+        resource.read(data.data(), resource.size());
+        return data;
+    }
+
+    // the bundle stores its integers in big endian
+    template<typename T> void writeValue(std::string &data, T value)
+    {
+        for(int i = sizeof(T) - 1; i >= 0; --i)
+            data += static_cast<char>((value >> (i * 8)) & 0xFF);
+    }
+
+    void writeString(std::string &data, const std::string &str)
+    {
+        writeValue<std::int32_t>(data, static_cast<std::int32_t>(str.size()));
+        data += str;
+    }
+}
+
+SyntheticImage makeChallengeImage(SyntheticLayout layout, std::uint64_t heapSize, double decoysPerMiB)
+{
+    SyntheticImage image;
+    image.heapSize = heapSize;
+    image.decoysPerMiB = decoysPerMiB;
+
+    SyntheticChallenge challenge;
+    challenge.layout = layout;
+
+    if(layout == SyntheticLayout::Dojo)
+    {
+        challenge.goal = 60;
+        challenge.limit = 5;
+        challenge.isg = "challenge_shaolin_default_normal.isg";
+    }
+
+    // the structure is located in the heap region holding the offset
+    const auto offset = heapSize / 4 * 3 / SyntheticProcessBackend::pageSize * SyntheticProcessBackend::pageSize + 0x123;
+    challenge.addresses[1] = image.heapBase + offset / image.regionSize * (image.regionSize + image.regionGap)
+        + offset % image.regionSize;
+    challenge.addresses[0] = image.lowBase + 0x5000 - 3;
+
+    image.challenges.push_back(challenge);
+    return image;
+}
+
+void makeBundle(const std::string &filename, std::size_t entryCount)
+{
+    std::mt19937 generator(9);
+
+    std::vector<std::string> filenames;
+    for(std::size_t i = 0; i < entryCount; ++i)
+        filenames.push_back("cache/itf_cooked/pc/world/bench/folder_" + std::to_string(i % 97)
+            + "/file_" + std::to_string(i) + ".ckd");
+
+    // the training room files are spread among the others
+    for(const auto &file : trainingRoomFiles)
+        filenames.insert(filenames.begin() + generator() % (filenames.size() + 1), file);
+
+    std::string table;
+    std::vector<char> content;
+
+    for(const auto &file : filenames)
+    {
+        std::vector<char> data;
+        if(std::find(trainingRoomFiles.begin(), trainingRoomFiles.end(), file) != trainingRoomFiles.end())
+        {
+            data = loadResource(file, false);
+            data.resize(std::max(data.size(), loadResource(file, true).size()), 0);
+        }
+        else
+            data.resize(0x40 + generator() % 0x100, '\x5A');
+
+        const auto slash = file.find_last_of('/') + 1;
+
+        writeValue<std::int32_t>(table, 1);
+        writeValue<std::int32_t>(table, static_cast<std::int32_t>(data.size()));
+        writeValue<std::int32_t>(table, 0);
+        writeValue<std::int64_t>(table, 0);
+        writeValue<std::int64_t>(table, static_cast<std::int64_t>(content.size()));
+        writeString(table, file.substr(0, slash));
+        writeString(table, file.substr(slash));
+        writeValue<std::int64_t>(table, 0);
+
+        content.insert(content.end(), data.begin(), data.end());
+    }
+
+    // address 0x0C holds the base offset of the files, address 0x2C the number of files
+    std::string header(0x2C, '\0');
+    writeValue<std::int32_t>(header, static_cast<std::int32_t>(filenames.size()));
+
+    const auto baseOffset = (header.size() + table.size() + 0xFFF) / 0x1000 * 0x1000;
+    std::string offset;
+    writeValue<std::int32_t>(offset, static_cast<std::int32_t>(baseOffset));
+    header.replace(0x0C, offset.size(), offset);
+
+    std::ofstream ofs(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    ofs << header << table << std::string(baseOffset - header.size() - table.size(), '\0');
+    ofs.write(content.data(), static_cast<std::streamsize>(content.size()));
+
+    if(!ofs)
+        throw std::runtime_error("Can't write bundle \"" + filename + "\"!");
+}
@@ -0,0 +1,19 @@
+#ifndef FIXTURES_H
+#define FIXTURES_H
+
+#include <string>
+
+#include "SyntheticProcess.hpp"
+
+// The fixtures stand in for the game, so that the benchmarks run anywhere.
+// They are generated from fixed seeds, two runs measure the same data.
+
+// an image of 'heapSize' bytes of heap, holding one challenge with the given layout
+// in its last quarter, so that most of the heap is scanned before finding it
+SyntheticImage makeChallengeImage(SyntheticLayout layout, std::uint64_t heapSize, double decoysPerMiB = 1);
+
+// writes a game data package holding the files of the training room, whose
+// content is the default one, among 'entryCount' other entries
+void makeBundle(const std::string &filename, std::size_t entryCount);
+
+#endif // FIXTURES_H
@@ -0,0 +1,167 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <memory>
+
+#include "Challenge.hpp"
+#include "ChallengeGroup.hpp"
+#include "Fixtures.hpp"
+#include "Snapshot.hpp"
+
+using std::cout;
+using std::endl;
+
+namespace
+{
+    void checkRules(const Challenge &challenge, const SyntheticChallenge &planted)
+    {
+        if(challenge.getSeed() != planted.seed || challenge.getGoal() != planted.goal || challenge.getLimit() != planted.limit)
+            fail("the loaded challenge differs from the fixture!");
+    }
+}
+
+void runLoadBench(const BenchOptions &options)
+{
+    const auto heapSize = options.heapSize * 1024 * 1024;
+
+    cout << "Challenge load benchmark (" << std::dec << options.heapSize << " MiB snapshots)" << endl;
+
+    for(auto layout : {SyntheticLayout::Regular, SyntheticLayout::Dojo})
+    {
+        const auto image = makeChallengeImage(layout, heapSize);
+        const auto snapshot = options.folder + "load.rlsnap";
+
+        SyntheticProcessBackend synthetic(image);
+        saveSnapshot(synthetic, snapshot);
+
+        cout << (layout == SyntheticLayout::Dojo ? "Dojo" : "Regular") << " challenge:" << endl;
+
+        // every cold load starts from a new challenge, which has no address nor scan cached
+        std::unique_ptr<Challenge> challenge;
+
+        report("Challenge::load (cold)", measure(options.runs,
+            [&]
+            {
+                challenge.reset(new Challenge);
+                challenge->openSnapshot(snapshot);
+            },
+            [&]{ challenge->load(); }), heapSize);
+
+        checkRules(*challenge, image.challenges.front());
+
+        // the same challenge only scans the pages which changed, and the likely regions first
+        report("Challenge::load (warm)", measure(options.runs,
+            [&]{ challenge->load(); }), heapSize);
+
+        checkRules(*challenge, image.challenges.front());
+
+        // reads the rules again, as the watcher does
+        report("Challenge::check", measure(options.runs * 50,
+            [&]
+            {
+                if(challenge->check() != ChallengeStatus::Unchanged)
+                    fail("the challenge changed!");
+            }));
+    }
+
+    // the same amount of memory, split between several instances of the game
+    const std::size_t instanceCount {4};
+
+    std::vector<SyntheticChallenge> planted;
+    std::vector<std::shared_ptr<ProcessBackend>> processes;
+
+    for(std::size_t i = 0; i < instanceCount; ++i)
+    {
+        auto image = makeChallengeImage(SyntheticLayout::Regular, heapSize / instanceCount);
+        image.seed = static_cast<unsigned>(i + 1);
+        image.challenges.front().seed += static_cast<unsigned>(i);
+
+        planted.push_back(image.challenges.front());
+        processes.push_back(std::make_shared<SyntheticProcessBackend>(image));
+    }
+
+    cout << std::dec << instanceCount << " instances:" << endl;
+
+    std::unique_ptr<ChallengeGroup> group;
+
+    report("Challenge::load, one at a time (cold)", measure(options.runs,
+        [&]
+        {
+            group.reset(new ChallengeGroup);
+            group->openProcesses(processes);
+        },
+        [&]
+        {
+            for(std::size_t i = 0; i < instanceCount; ++i)
+                group->getInstance(i).load();
+        }), heapSize);
+
+    report("ChallengeGroup::load (cold)", measure(options.runs,
+        [&]
+        {
+            group.reset(new ChallengeGroup);
+            group->openProcesses(processes);
+        },
+        [&]
+        {
+            if(group->load() != instanceCount)
+                fail("an instance was not loaded!");
+        }), heapSize);
+
+    for(std::size_t i = 0; i < instanceCount; ++i)
+        checkRules(group->getInstance(i), planted[i]);
+
+    report("ChallengeGroup::updateRules (all)", measure(options.runs,
+        [&]
+        {
+            if(!group->updateRules(ChallengeGroup::all, planted[0].seed, planted[0].goal, planted[0].limit))
+                fail("an instance was not updated!");
+        }));
+
+    for(std::size_t i = 0; i < instanceCount; ++i)
+        checkRules(group->getInstance(i), planted[0]);
+}
+
+void runScaleBench(const BenchOptions &options)
+{
+    // the biggest images take seconds to scan
+    const auto runs = std::min(options.runs, 3u);
+
+    cout << "Challenge load scaling benchmark (generated memory, up to " << std::dec
+        << options.virtualSize << " GiB)" << endl;
+
+    for(std::uint64_t size = 1; size <= options.virtualSize; size *= 4)
+    {
+        const std::uint64_t heapSize {size * 1024 * 1024 * 1024};
+
+        for(double decoysPerMiB : {0.0, 4.0, 64.0})
+        {
+            const auto image = makeChallengeImage(SyntheticLayout::Regular, heapSize, decoysPerMiB);
+            const auto process = std::make_shared<SyntheticProcessBackend>(image);
+
+            cout << std::dec << size << " GiB, " << std::defaultfloat << decoysPerMiB << " decoys per MiB:" << endl;
+
+            // the generation of the pages is measured alone, it is part of every scan
+            std::vector<char> block(Process::defaultScanBlockSize);
+
+            report("generation", measure(runs, [&]
+            {
+                for(const auto &region : process->getRegions())
+                    for(std::size_t offset = 0; offset < region.size; offset += block.size())
+                        process->read(region.base + offset, block.data(), std::min(block.size(), region.size - offset));
+            }), heapSize);
+
+            std::unique_ptr<Challenge> challenge;
+
+            report("Challenge::load", measure(runs,
+                [&]
+                {
+                    challenge.reset(new Challenge);
+                    challenge->openProcess(process);
+                },
+                [&]{ challenge->load(); }), heapSize);
+
+            checkRules(*challenge, image.challenges.front());
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#include "Bench.hpp"
+
+#include "Fixtures.hpp"
+#include "Process.hpp"
+#include "Snapshot.hpp"
+
+using std::cout;
+using std::endl;
+
+void runScanBench(const BenchOptions &options)
+{
+    // the generated memory is saved as a snapshot, so that the generation is not measured
+    const auto snapshot = options.folder + "scan.rlsnap";
+    SyntheticProcessBackend synthetic(makeChallengeImage(SyntheticLayout::Regular, options.heapSize * 1024 * 1024));
+    saveSnapshot(synthetic, snapshot);
+
+    Process process;
+    {
+        QuietOutput quiet;
+        process.openSnapshot(snapshot);
+    }
+
+    std::size_t size {0};
+    for(const auto &region : process.getRegions())
+        size += region.size;
+
+    cout << "Process scan benchmark (" << std::dec << size / (1024 * 1024) << " MiB snapshot, "
+        << process.getScanThreadCount() << " threads)" << endl;
+
+    // the missing patterns make the scans go through the whole memory
+    const std::string missing("challenge_drc_castle_lumsattack_expert.isg");
+    const PatternSet anchors({std::string("countdown.act", 14), std::string("countdown_shaolin.act", 22), ".isg"});
+    const Signature signature("DE AD ?? ?? BE EF 00 00 ?? 01 02 03");
+
+    auto expectMissing = [](Address address)
+    {
+        if(address != Process::npos)
+            fail("found a missing pattern!");
+    };
+
+    report("Process::findString", measure(options.runs,
+        [&]{ expectMissing(process.findString(missing)); }), size);
+
+    report("Process::findString (backwards)", measure(options.runs,
+        [&]{ expectMissing(process.findString(missing, Process::npos, true)); }), size);
+
+    report("Process::findSignature", measure(options.runs,
+        [&]{ expectMissing(process.findSignature(signature)); }), size);
+
+    // the matches of both passes must be the same
+    std::size_t matchCount {0};
+
+    report("Process::findStrings", measure(options.runs, [&]{ process.clearScanCache(); },
+        [&]{ matchCount = process.findStrings(anchors).size(); }), size);
+
+    report("Process::findStrings (unchanged)", measure(options.runs,
+        [&]{ if(process.findStrings(anchors).size() != matchCount) fail("the incremental scan differs!"); }), size);
+}
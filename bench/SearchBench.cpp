@@ -0,0 +1,67 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+#include "ByteSearch.hpp"
+#include "SyntheticProcess.hpp"
+
+using std::cout;
+using std::endl;
+
+void runSearchBench(const BenchOptions &options)
+{
+    const std::size_t size {options.heapSize * 1024 * 1024};
+    const std::vector<std::string> patterns{"countdown", "countdown.act", "countdown_shaolin.act",
+        "challenge_spikyroad_timeattack_expert.isg"};
+
+    cout << "Byte search benchmark (" << options.heapSize << " MiB of heap-like data, kernel: "
+        << getByteSearchKernel() << ")" << endl;
+
+    // a single region of the synthetic heap, without zeroed pages nor decoys
+    SyntheticImage image;
+    image.seed = 42;
+    image.heapSize = size;
+    image.regionSize = size;
+    image.zeroPageRatio = 0;
+    image.decoysPerMiB = 0;
+
+    std::vector<char> data(size);
+    SyntheticProcessBackend(image).read(image.heapBase, data.data(), data.size());
+
+    const auto first = data.data();
+    const auto last = data.data() + data.size();
+
+    for(const auto &pattern : patterns)
+    {
+        // the pattern is planted at both ends so that each search direction goes through the whole buffer
+        std::fill_n(data.begin(), 64, 1);
+        std::fill_n(data.end() - 64, 64, 1);
+        std::copy(pattern.begin(), pattern.end(), data.begin() + 8);
+        std::copy(pattern.begin(), pattern.end(), data.end() - 8 - pattern.size());
+
+        const auto front = first + 8;
+        const auto back = last - 8 - pattern.size();
+        const auto p = pattern.data();
+        const auto n = pattern.size();
+
+        auto check = [](const char *result, const char *expected)
+        {
+            if(result != expected)
+                fail("wrong search result!");
+        };
+
+        const auto stdForward = measure(options.runs, [&]{ check(std::search(front + 1, last, p, p + n), back); });
+        const auto simdForward = measure(options.runs, [&]{ check(searchBytes(front + 1, last, p, n), back); });
+        const auto stdBackwards = measure(options.runs, [&]{ check(std::find_end(first, back + n - 1, p, p + n), front); });
+        const auto simdBackwards = measure(options.runs, [&]{ check(searchBytesBackwards(first, back + n - 1, p, n), front); });
+
+        cout << "\"" << pattern << "\":" << endl;
+        report("std::search", stdForward, size);
+        report("searchBytes", simdForward, size);
+        report("std::find_end", stdBackwards, size);
+        report("searchBytesBackwards", simdBackwards, size);
+        cout << "  speedup: " << std::fixed << std::setprecision(2) << stdForward.getPercentile(50) / simdForward.getPercentile(50)
+            << "x forward, " << stdBackwards.getPercentile(50) / simdBackwards.getPercentile(50) << "x backwards" << endl;
+    }
+}
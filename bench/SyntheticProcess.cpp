@@ -0,0 +1,319 @@
+#include "SyntheticProcess.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    const Address searchLimit {0x1000'0000};
+
+    const char *const words[] {"count", "down", "counter", ".act", "act", "cooked",
+        "challenge_", "default", "normal", "expert", "_shaolin", ".isg", "countdow"};
+    const std::size_t wordCount {sizeof(words) / sizeof(words[0])};
+
+    std::uint64_t splitMix(std::uint64_t value) noexcept
+    {
+        value += 0x9E37'79B9'7F4A'7C15;
+        value = (value ^ (value >> 30)) * 0xBF58'476D'1CE4'E5B9;
+        value = (value ^ (value >> 27)) * 0x94D0'49BB'1331'11EB;
+        return value ^ (value >> 31);
+    }
+
+    // xorshift64*, fast enough for the generation not to hide the scans
+    std::uint64_t next(std::uint64_t &state) noexcept
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545'F491'4F6C'DD1D;
+    }
+
+    // returns a random number in [0, 1)
+    double nextRatio(std::uint64_t &state) noexcept
+    {
+        return static_cast<double>(next(state) >> 11) / static_cast<double>(std::uint64_t {1} << 53);
+    }
+
+    std::string toBigEndian(std::uint32_t value)
+    {
+        std::string bytes(4, '\0');
+        for(int i = 3; i >= 0; --i, value >>= 8)
+            bytes[i] = static_cast<char>(value & 0xFF);
+
+        return bytes;
+    }
+
+    // the part of the challenge structure read by 'Challenge::readRules'
+    std::string makeRules(const SyntheticChallenge &challenge)
+    {
+        std::string rules(0x34, '\0');
+        rules.replace(0, 4, toBigEndian(challenge.seed));
+        std::memcpy(&rules[0x0C], &challenge.goal, sizeof(challenge.goal));
+        std::memcpy(&rules[0x10], &challenge.limit, sizeof(challenge.limit));
+
+        return rules + challenge.isg + '\0';
+    }
+}
+
+Address SyntheticChallenge::getSeedAddress() const noexcept
+{
+    return addresses[1] + (layout == SyntheticLayout::Dojo ? 0x12C : 0x5F8);
+}
+
+SyntheticProcessBackend::SyntheticProcessBackend(const SyntheticImage &image) :
+    m_image(image)
+{
+    if(m_image.regionSize == 0 || m_image.regionSize % pageSize != 0 || m_image.lowSize % pageSize != 0
+        || m_image.lowBase % pageSize != 0 || m_image.heapBase % pageSize != 0 || m_image.regionGap % pageSize != 0)
+            throw std::invalid_argument("The synthetic regions must be made of whole pages.");
+
+    if(m_image.lowBase + m_image.lowSize > m_image.heapBase)
+        throw std::invalid_argument("The low region must be located below the heap.");
+
+    MemoryRegion low;
+    low.base = m_image.lowBase;
+    low.size = m_image.lowSize;
+    low.writable = true;
+    m_regions.push_back(low);
+
+    for(std::uint64_t offset = 0; offset < m_image.heapSize; offset += m_image.regionSize)
+    {
+        MemoryRegion region;
+        region.base = m_image.heapBase + offset / m_image.regionSize * (m_image.regionSize + m_image.regionGap);
+        region.size = static_cast<std::size_t>(std::min<std::uint64_t>(m_image.regionSize, m_image.heapSize - offset));
+        region.writable = true;
+        m_regions.push_back(region);
+    }
+
+    // the copies of the ISG filenames are planted first, so that the structures are written over them
+    for(const auto &challenge : m_image.challenges)
+        for(auto offset = m_image.lowSize / 16; offset + challenge.isg.size() < m_image.lowSize; offset += m_image.lowSize / 8)
+            m_patches.push_back({m_image.lowBase + offset, challenge.isg + '\0'});
+
+    for(const auto &challenge : m_image.challenges)
+        plant(challenge);
+}
+
+void SyntheticProcessBackend::plant(const SyntheticChallenge &challenge)
+{
+    const bool isDojo = challenge.layout == SyntheticLayout::Dojo;
+    const auto seedAddress = challenge.getSeedAddress();
+    const auto nameAddress = seedAddress + (isDojo ? 0x74 : 0x0C);
+
+    // 01 00 00 00 <seed> 00 00 00 00 00 00 00 00 "countdown.act"
+    // or the 0x44 bytes of the Dojo signature and "countdown_shaolin.act"
+    std::string signature(isDojo ? 0x44 : 0x10, '\0');
+    if(isDojo)
+    {
+        signature[0x00] = signature[0x04] = 2;
+        signature[0x14] = 1;
+    }
+    else
+        signature[0x00] = 1;
+
+    const std::string name(isDojo ? "countdown_shaolin.act" : "countdown.act");
+    const std::vector<Patch> patches {
+        {challenge.addresses[0], makeRules(challenge)},
+        {challenge.addresses[1], makeRules(challenge)},
+        {nameAddress - signature.size(), signature + name + '\0'},
+        {seedAddress, toBigEndian(challenge.seed)}};
+
+    if(challenge.addresses[0] >= searchLimit)
+        throw std::invalid_argument("The first address of a synthetic challenge must be below 0x10000000.");
+
+    for(const auto &patch : patches)
+    {
+        if(!contains(patch.address, patch.bytes.size()))
+            throw std::invalid_argument("A synthetic challenge is located outside of the regions.");
+
+        m_patches.push_back(patch);
+    }
+}
+
+bool SyntheticProcessBackend::read(Address address, char *buffer, std::size_t length) noexcept
+{
+    if(!contains(address, length))
+        return false;
+
+    // the reads only wait for each other once a page was written
+    const bool hasWrittenPages = m_hasWrittenPages;
+    std::unique_lock<std::mutex> lock(m_writtenPagesMutex, std::defer_lock);
+    if(hasWrittenPages)
+        lock.lock();
+
+    std::array<char, pageSize> page;
+
+    while(length > 0)
+    {
+        const auto pageAddress = address / pageSize * pageSize;
+        const auto offset = static_cast<std::size_t>(address - pageAddress);
+        const auto size = std::min(length, pageSize - offset);
+
+        const auto written = hasWrittenPages ? m_writtenPages.find(pageAddress) : m_writtenPages.end();
+        if(written != m_writtenPages.end())
+            std::copy_n(written->second.data() + offset, size, buffer);
+
+        // the whole pages are generated in place
+        else if(size == pageSize)
+            generatePage(pageAddress, buffer);
+
+        else
+        {
+            generatePage(pageAddress, page.data());
+            std::copy_n(page.data() + offset, size, buffer);
+        }
+
+        address += size;
+        buffer += size;
+        length -= size;
+    }
+
+    return true;
+}
+
+bool SyntheticProcessBackend::write(Address address, const char *buffer, std::size_t length) noexcept
+{
+    if(!contains(address, length))
+        return false;
+
+    std::lock_guard<std::mutex> guard(m_writtenPagesMutex);
+    m_hasWrittenPages = true;
+
+    while(length > 0)
+    {
+        const auto pageAddress = address / pageSize * pageSize;
+        const auto offset = static_cast<std::size_t>(address - pageAddress);
+        const auto size = std::min(length, pageSize - offset);
+
+        auto &page = m_writtenPages[pageAddress];
+        if(page.empty())
+        {
+            page.resize(pageSize);
+            generatePage(pageAddress, page.data());
+        }
+
+        std::copy_n(buffer, size, page.begin() + offset);
+
+        address += size;
+        buffer += size;
+        length -= size;
+    }
+
+    return true;
+}
+
+std::vector<MemoryRegion> SyntheticProcessBackend::getRegions() noexcept
+{
+    return m_regions;
+}
+
+unsigned SyntheticProcessBackend::getProcessId() const noexcept
+{
+    return 1;
+}
+
+std::string SyntheticProcessBackend::getModuleName() noexcept
+{
+    return "Rayman Legends.exe";
+}
+
+// the synthetic process has no module, nor a launch to identify
+std::vector<Module> SyntheticProcessBackend::getModules() noexcept
+{
+    return std::vector<Module>();
+}
+
+std::uint64_t SyntheticProcessBackend::getStartTime() noexcept
+{
+    return 0;
+}
+
+bool SyntheticProcessBackend::isAlive() noexcept
+{
+    return true;
+}
+
+bool SyntheticProcessBackend::contains(Address address, std::size_t length) const noexcept
+{
+    auto region = std::upper_bound(m_regions.begin(), m_regions.end(), address,
+        [](Address address, const MemoryRegion &region){ return address < region.base; });
+
+    if(region == m_regions.begin())
+        return false;
+
+    --region;
+    return address - region->base < region->size && length <= region->end() - address;
+}
+
+void SyntheticProcessBackend::generatePage(Address address, char *data) const noexcept
+{
+    std::uint64_t state {splitMix(m_image.seed ^ splitMix(address)) | 1};
+
+    if(nextRatio(state) < m_image.zeroPageRatio)
+        std::fill_n(data, pageSize, 0);
+
+    else
+        for(std::size_t i = 0; i < pageSize; i += 16)
+        {
+            const auto random = next(state);
+            const auto kind = random % 100;
+            auto block = data + i;
+
+            if(kind < 40)
+                std::fill_n(block, 16, 0);
+
+            // four small integers
+            else if(kind < 65)
+            {
+                const auto values = next(state);
+                for(int j = 0; j < 4; ++j)
+                {
+                    const std::uint32_t value = (values >> (j * 8)) & 0xFF;
+                    std::memcpy(block + j * 4, &value, sizeof(value));
+                }
+            }
+
+            // four pointers
+            else if(kind < 85)
+            {
+                const auto values = next(state);
+                for(int j = 0; j < 4; ++j)
+                {
+                    const std::uint32_t value = 0x0100'0000 + ((values >> (j * 16)) & 0xFFFF) * 0xF00;
+                    std::memcpy(block + j * 4, &value, sizeof(value));
+                }
+            }
+
+            else
+            {
+                const auto word = words[(random >> 32) % wordCount];
+                std::fill_n(block, 16, 0);
+                std::copy_n(word, std::strlen(word), block);
+            }
+        }
+
+    // the decoys are not preceded by a signature, both countdown filenames are planted
+    auto decoys = m_image.decoysPerMiB * pageSize / 0x10'0000;
+    for(; decoys > 0; decoys -= 1)
+    {
+        if(decoys < 1 && nextRatio(state) >= decoys)
+            break;
+
+        const std::string decoy(next(state) % 2 ? "countdown_shaolin.act" : "countdown.act");
+        const auto offset = 0x44 + next(state) % (pageSize - 0x44 - 0x20);
+
+        std::fill_n(data + offset - 0x44, 0x44, '\xCD');
+        std::copy_n(decoy.c_str(), decoy.size() + 1, data + offset);
+    }
+
+    for(const auto &patch : m_patches)
+    {
+        const auto first = std::max(patch.address, address);
+        const auto last = std::min(patch.address + patch.bytes.size(), address + pageSize);
+
+        if(first < last)
+            std::copy(patch.bytes.begin() + (first - patch.address), patch.bytes.begin() + (last - patch.address),
+                data + (first - address));
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef SYNTHETICPROCESS_H
+#define SYNTHETICPROCESS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ProcessBackend.hpp"
+
+enum class SyntheticLayout { Regular, Dojo };
+
+// a challenge planted in the generated memory
+struct SyntheticChallenge
+{
+    SyntheticLayout layout {SyntheticLayout::Regular};
+
+    // the structures holding the rules, the seed and its countdown filename follow
+    // 'addresses[1]', 'addresses[0]' must be located below 0x1000'0000
+    std::array<Address, 2> addresses {{0, 0}};
+
+    unsigned seed {0xDEAD'BEEF};
+    float goal {123.5f};
+    float limit {42};
+    std::string isg {"challenge_run_timeattack_expert.isg"};
+
+    // the seed preceding the countdown filename:
+    // 'addresses[1]' + 0x5F8 (regular layout) or + 0x12C (Dojo layout)
+    Address getSeedAddress() const noexcept;
+};
+
+// what the generated memory looks like
+struct SyntheticImage
+{
+    // the same settings always generate the same memory
+    unsigned seed {1};
+
+    // the heap is split into regions separated by unmapped gaps
+    Address heapBase {0x2000'0000};
+    std::uint64_t heapSize {0x1000'0000};
+    std::size_t regionSize {0x400'0000};
+    std::size_t regionGap {0x100'0000};
+
+    // a small region below the heap, where 'SyntheticChallenge::addresses[0]' are located
+    // it holds copies of the ISG filenames which are not preceded by the seed
+    Address lowBase {0x0800'0000};
+    std::size_t lowSize {0x10'0000};
+
+    // share of the pages which are filled with zeros
+    double zeroPageRatio {0.25};
+
+    // countdown filenames which are not preceded by their signature
+    double decoysPerMiB {1};
+
+    std::vector<SyntheticChallenge> challenges;
+};
+
+// A process whose memory is generated page by page when it is read, so that the
+// scans can be measured over tens of gigabytes without holding them.
+// The pages look like a game heap: zeroed blocks, small integers, pointers and
+// short strings sharing bytes with the searched filenames.
+// The writes are kept in memory.
+class SyntheticProcessBackend : public ProcessBackend
+{
+    public:
+        // throws std::invalid_argument if a challenge is not in the generated regions
+        SyntheticProcessBackend(const SyntheticImage &image);
+
+        bool read(Address address, char *buffer, std::size_t length) noexcept override;
+        bool write(Address address, const char *buffer, std::size_t length) noexcept override;
+        std::vector<MemoryRegion> getRegions() noexcept override;
+        unsigned getProcessId() const noexcept override;
+        std::string getModuleName() noexcept override;
+        std::vector<Module> getModules() noexcept override;
+        std::uint64_t getStartTime() noexcept override;
+        bool isAlive() noexcept override;
+
+        static const std::size_t pageSize {0x1000};
+
+    private:
+        // bytes written over the generated pages
+        struct Patch
+        {
+            Address address;
+            std::string bytes;
+        };
+
+        void plant(const SyntheticChallenge &challenge);
+
+        // returns true if [address, address + length) is in the regions
+        bool contains(Address address, std::size_t length) const noexcept;
+
+        // writes the content of the page located at 'address' into 'data'
+        void generatePage(Address address, char *data) const noexcept;
+
+        SyntheticImage m_image;
+        std::vector<MemoryRegion> m_regions;
+        std::vector<Patch> m_patches;
+
+        // pages modified through 'write', by address
+        std::map<Address, std::vector<char>> m_writtenPages;
+        std::mutex m_writtenPagesMutex;
+        std::atomic<bool> m_hasWrittenPages {false};
+};
+
+#endif // SYNTHETICPROCESS_H
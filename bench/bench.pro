@@ -0,0 +1,84 @@
+QT = core
+CONFIG += console c++14
+CONFIG -= app_bundle
+
+TARGET = rlcm-bench
+
+TEMPLATE = app
+
+QMAKE_CXXFLAGS += -Wall -Wextra -pedantic -pedantic-errors
+QMAKE_CXXFLAGS += -Wmain -Wswitch-enum -Wmissing-include-dirs
+QMAKE_CXXFLAGS += -Wunreachable-code -Wundef -Wcast-align -Wredundant-decls
+QMAKE_CXXFLAGS += -Winit-self -Wnon-virtual-dtor -Wold-style-cast -Woverloaded-virtual
+QMAKE_CXXFLAGS += -Wwrite-strings -Wpointer-arith -Wcast-qual -Wlogical-op
+QMAKE_CXXFLAGS += -Wuninitialized -fexceptions
+
+INCLUDEPATH += ../src
+
+win32 {
+    LIBS += -lpsapi
+    SOURCES += ../src/WindowsProcess.cpp
+}
+
+unix {
+    SOURCES += ../src/LinuxProcess.cpp
+}
+
+SOURCES += Bench.cpp \
+    BundleBench.cpp \
+    Fixtures.cpp \
+    LoadBench.cpp \
+    main.cpp \
+    ScanBench.cpp \
+    SearchBench.cpp \
+    SyntheticProcess.cpp \
+    ../src/AddressCache.cpp \
+    ../src/Bundle.cpp \
+    ../src/ByteSearch.cpp \
+    ../src/Challenge.cpp \
+    ../src/ChallengeGroup.cpp \
+    ../src/Clock.cpp \
+    ../src/Json.cpp \
+    ../src/OccurrenceIndex.cpp \
+    ../src/PatternSet.cpp \
+    ../src/PointerChain.cpp \
+    ../src/Process.cpp \
+    ../src/ProcessRegistry.cpp \
+    ../src/RegionStats.cpp \
+    ../src/ScanControl.cpp \
+    ../src/ScanPool.cpp \
+    ../src/ScanStats.cpp \
+    ../src/Signature.cpp \
+    ../src/Snapshot.cpp \
+    ../src/WriteTransaction.cpp
+
+HEADERS += Bench.hpp \
+    Fixtures.hpp \
+    SyntheticProcess.hpp \
+    ../src/AddressCache.hpp \
+    ../src/Bundle.hpp \
+    ../src/ByteOrder.hpp \
+    ../src/ByteSearch.hpp \
+    ../src/Challenge.hpp \
+    ../src/ChallengeGroup.hpp \
+    ../src/ChallengeLayout.hpp \
+    ../src/Clock.hpp \
+    ../src/Hash.hpp \
+    ../src/Json.hpp \
+    ../src/NullBuffer.hpp \
+    ../src/OccurrenceIndex.hpp \
+    ../src/PatternSet.hpp \
+    ../src/PointerChain.hpp \
+    ../src/Process.hpp \
+    ../src/ProcessBackend.hpp \
+    ../src/ProcessRegistry.hpp \
+    ../src/RegionStats.hpp \
+    ../src/ScanCache.hpp \
+    ../src/ScanControl.hpp \
+    ../src/ScanPool.hpp \
+    ../src/ScanStats.hpp \
+    ../src/Signature.hpp \
+    ../src/Snapshot.hpp \
+    ../src/WriteTransaction.hpp
+
+RESOURCES += ../data/rsrc.qrc
@@ -0,0 +1,128 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <QDir>
+#include <QTemporaryDir>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace
+{
+    void printUsage()
+    {
+        cout << "Usage: rlcm-bench [options] [search] [scan] [load] [scale] [bundle]" << endl
+            << "Runs the given suites, or all of them." << endl
+            << "  --runs N       measured runs of each case (default: 20)" << endl
+            << "  --heap MIB     size of the heap of the fixtures (default: 256)" << endl
+            << "  --virtual GIB  size of the biggest generated memory of the scale suite (default: 4)" << endl
+            << "  --entries N    entries of the bundle fixture (default: 20000)" << endl
+            << "  --folder PATH  folder of the fixture files (default: a temporary folder)" << endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    BenchOptions options;
+    std::vector<std::string> suites;
+
+    try
+    {
+        for(int i = 1; i < argc; ++i)
+        {
+            const std::string arg(argv[i]);
+
+            if(arg == "--help" || arg == "-h")
+            {
+                printUsage();
+                return 0;
+            }
+
+            if(arg.compare(0, 2, "--") != 0)
+            {
+                suites.push_back(arg);
+                continue;
+            }
+
+            if(i + 1 == argc)
+                throw std::invalid_argument("Missing value of " + arg + ".");
+
+            const std::string value(argv[++i]);
+
+            if(arg == "--runs")
+                options.runs = static_cast<unsigned>(std::stoul(value));
+            else if(arg == "--heap")
+                options.heapSize = std::stoul(value);
+            else if(arg == "--virtual")
+                options.virtualSize = std::stoull(value);
+            else if(arg == "--entries")
+                options.bundleEntryCount = std::stoul(value);
+            else if(arg == "--folder")
+                options.folder = value;
+            else
+                throw std::invalid_argument("Unknown option " + arg + ".");
+        }
+
+        if(options.runs == 0 || options.heapSize < 16)
+            throw std::invalid_argument("At least 1 run and 16 MiB of heap are needed.");
+    }
+    catch(const std::exception &e)
+    {
+        cerr << "Error: " << e.what() << endl;
+        printUsage();
+        return 1;
+    }
+
+    QTemporaryDir temporaryFolder;
+    if(options.folder.empty())
+    {
+        if(!temporaryFolder.isValid())
+        {
+            cerr << "Error: Can't create a temporary folder!" << endl;
+            return 1;
+        }
+
+        options.folder = temporaryFolder.path().toStdString();
+    }
+
+    options.folder = QDir::fromNativeSeparators(QString::fromStdString(options.folder)).toStdString();
+    if(options.folder.back() != '/')
+        options.folder += '/';
+
+    const std::vector<std::pair<std::string, void(*)(const BenchOptions&)>> allSuites{
+        {"search", runSearchBench}, {"scan", runScanBench}, {"load", runLoadBench}, {"scale", runScaleBench}, {"bundle", runBundleBench}};
+
+    if(suites.empty())
+        for(const auto &suite : allSuites)
+            suites.push_back(suite.first);
+
+    cout << "Latencies of " << options.runs << " runs (after a warm-up run), throughputs from the median" << endl;
+
+    try
+    {
+        for(const auto &name : suites)
+        {
+            const auto suite = std::find_if(allSuites.begin(), allSuites.end(),
+                [&name](const auto &s){ return s.first == name; });
+
+            if(suite == allSuites.end())
+                throw std::invalid_argument("Unknown suite \"" + name + "\".");
+
+            cout << endl;
+            suite->second(options);
+        }
+    }
+    catch(const std::exception &e)
+    {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,335 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Bundle.hpp"
+#include "Challenge.hpp"
+#include "Clock.hpp"
+#include "GameFolder.hpp"
+#include "Json.hpp"
+#include "NullBuffer.hpp"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+namespace
+{
+    // exit codes
+    const int success {0};
+    const int usageError {1};
+    const int failure {2};
+    const int notInstalled {3};
+
+    struct Options
+    {
+        std::string command;
+
+        std::string gameFolder;
+        std::string snapshotFilename;
+        bool useCache {true};
+        bool printStats {false};
+        bool verbose {false};
+        unsigned repeat {1};
+
+        // scan budgets of each load, 0 means no limit
+        double timeout {0};
+        std::size_t maxBytes {0};
+
+        bool hasSeed {false};
+        bool hasGoal {false};
+        bool hasLimit {false};
+        unsigned seed {0};
+        float goal {0};
+        float limit {0};
+    };
+
+    void printUsage(std::ostream &os)
+    {
+        os << "Usage: rlcm-cli <command> [options]" << endl
+            << "Commands:" << endl
+            << "  load                 loads the running challenge and prints it as JSON" << endl
+            << "  apply                loads the challenge, applies the given rules and prints them" << endl
+            << "  check-training       exits with 0 if the training room is installed, 3 otherwise" << endl
+            << "  install-training     installs the training room into the game data" << endl
+            << "  uninstall-training   restores the original game data" << endl
+            << "Options:" << endl
+            << "  --seed SEED          seed to apply, in hexadecimal (\"DEADBEEF\" or \"DE AD BE EF\")" << endl
+            << "  --goal VALUE         goal to apply" << endl
+            << "  --limit VALUE        score limit to apply" << endl
+            << "  --game-folder PATH   folder of the game, located through the running game by default" << endl
+            << "  --snapshot FILE      loads a memory snapshot instead of the running game" << endl
+            << "  --no-cache           ignores the addresses and regions saved by the previous sessions" << endl
+            << "  --stats              adds the statistics of the last load to the JSON output" << endl
+            << "  --repeat N           runs the command N times and prints its latencies" << endl
+            << "  --timeout SECONDS    stops the scans of each load after SECONDS" << endl
+            << "  --max-bytes N        stops the scans of each load after N bytes" << endl
+            << "  --verbose            writes the progress messages to the error output" << endl
+            << "Exit codes: 0 success, 1 invalid arguments, 2 failure, 3 training room not installed" << endl;
+    }
+
+    unsigned parseSeed(std::string str)
+    {
+        str.erase(std::remove(str.begin(), str.end(), ' '), str.end());
+        if(str.compare(0, 2, "0x") == 0 || str.compare(0, 2, "0X") == 0)
+            str.erase(0, 2);
+
+        std::size_t length {0};
+        const auto seed = str.size() <= 8 ? std::stoul(str, &length, 16) : 0;
+        if(str.empty() || length != str.size() || seed == 0)
+            throw std::invalid_argument("Invalid seed \"" + str + "\".");
+
+        return static_cast<unsigned>(seed);
+    }
+
+    float parseFloat(const std::string &str)
+    {
+        std::size_t length {0};
+        const auto value = std::stof(str, &length);
+        if(length != str.size())
+            throw std::invalid_argument("Invalid value \"" + str + "\".");
+
+        return value;
+    }
+
+    Options parseArguments(int argc, char *argv[])
+    {
+        Options options;
+
+        for(int i = 1; i < argc; ++i)
+        {
+            const std::string arg(argv[i]);
+
+            auto nextValue = [&]
+            {
+                if(i + 1 == argc)
+                    throw std::invalid_argument("Missing value of " + arg + ".");
+
+                return std::string(argv[++i]);
+            };
+
+            if(arg == "--seed")
+            {
+                options.seed = parseSeed(nextValue());
+                options.hasSeed = true;
+            }
+            else if(arg == "--goal")
+            {
+                options.goal = parseFloat(nextValue());
+                options.hasGoal = true;
+            }
+            else if(arg == "--limit")
+            {
+                options.limit = parseFloat(nextValue());
+                options.hasLimit = true;
+            }
+            else if(arg == "--game-folder")
+                options.gameFolder = nextValue();
+            else if(arg == "--snapshot")
+                options.snapshotFilename = nextValue();
+            else if(arg == "--no-cache")
+                options.useCache = false;
+            else if(arg == "--stats")
+                options.printStats = true;
+            else if(arg == "--repeat")
+                options.repeat = static_cast<unsigned>(std::stoul(nextValue()));
+            else if(arg == "--timeout")
+                options.timeout = parseFloat(nextValue());
+            else if(arg == "--max-bytes")
+                options.maxBytes = static_cast<std::size_t>(std::stoull(nextValue()));
+            else if(arg == "--verbose")
+                options.verbose = true;
+            else if(arg.compare(0, 2, "--") != 0 && options.command.empty())
+                options.command = arg;
+            else
+                throw std::invalid_argument("Unexpected argument \"" + arg + "\".");
+        }
+
+        const std::vector<std::string> commands{"load", "apply", "check-training", "install-training", "uninstall-training"};
+        if(std::find(commands.begin(), commands.end(), options.command) == commands.end())
+            throw std::invalid_argument(options.command.empty() ? "Missing command." : "Unknown command \"" + options.command + "\".");
+
+        if(options.command == "apply" && !options.hasSeed && !options.hasGoal && !options.hasLimit)
+            throw std::invalid_argument("Nothing to apply, give --seed, --goal or --limit.");
+
+        if(options.repeat == 0)
+            throw std::invalid_argument("At least 1 run is needed.");
+
+        if(options.timeout < 0)
+            throw std::invalid_argument("The timeout can't be negative.");
+
+        return options;
+    }
+
+    void printChallenge(std::ostream &os, Challenge &challenge, bool printStats)
+    {
+        std::ostringstream seed;
+        seed << std::hex << std::uppercase << std::setfill('0') << std::setw(8) << challenge.getSeed();
+
+        os << "{\n    \"level\": " << toJsonString(challenge.getLevelName())
+            << ",\n    \"event\": " << toJsonString(challenge.getEventName())
+            << ",\n    \"difficulty\": " << toJsonString(challenge.getDifficultyName())
+            << ",\n    \"seed\": \"" << seed.str() << '"'
+            << ",\n    \"goal\": " << toJsonNumber(challenge.getGoal())
+            << ",\n    \"goalType\": " << toJsonString(challenge.getGoalType())
+            << ",\n    \"limit\": " << toJsonNumber(challenge.getLimit())
+            << ",\n    \"limitType\": " << toJsonString(challenge.getLimitType());
+
+        // the statistics are indented one level deeper
+        if(printStats)
+        {
+            std::istringstream stats(challenge.getStats().toJson());
+            std::string line;
+
+            os << ",\n    \"stats\": ";
+            for(const char *separator = ""; std::getline(stats, line); separator = "\n    ")
+                os << separator << line;
+        }
+
+        os << "\n}" << endl;
+    }
+
+    // prints the latencies of the runs to the error output
+    void printLatencies(std::vector<double> times)
+    {
+        std::sort(times.begin(), times.end());
+
+        auto percentile = [&times](double percent)
+        {
+            return getPercentile(times, percent) * 1000;
+        };
+
+        double total {0};
+        for(auto time : times)
+            total += time;
+
+        cerr << std::fixed << std::setprecision(3) << times.size() << " runs (ms): min " << times.front() * 1000
+            << ", mean " << total / times.size() * 1000 << ", p50 " << percentile(50) << ", p90 " << percentile(90)
+            << ", p99 " << percentile(99) << ", max " << times.back() * 1000 << endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    for(int i = 1; i < argc; ++i)
+        if(std::string(argv[i]) == "--help" || std::string(argv[i]) == "-h")
+        {
+            printUsage(cout);
+            return success;
+        }
+
+    Options options;
+
+    try
+    {
+        options = parseArguments(argc, argv);
+    }
+    catch(const std::exception &e)
+    {
+        cerr << "Error: " << e.what() << endl;
+        printUsage(cerr);
+        return usageError;
+    }
+
+    // the standard output only holds the result, the progress messages are hidden
+    const auto outputBuffer = cout.rdbuf();
+    NullBuffer nullBuffer;
+    cout.rdbuf(options.verbose ? cerr.rdbuf() : &nullBuffer);
+
+    const std::string exePath(argv[0]);
+    const auto exeFolder = exePath.substr(0, exePath.find_last_of("/\\") + 1);
+
+    Challenge challenge;
+    if(options.useCache)
+    {
+        challenge.setAddressCacheFile(exeFolder + "addresses.sav");
+        challenge.setRegionStatsFile(exeFolder + "regions.sav");
+    }
+
+    challenge.setPointerChainFile(exeFolder + "pointers.txt");
+    challenge.getScanControl().setTimeBudget(options.timeout);
+    challenge.getScanControl().setByteBudget(options.maxBytes);
+
+    const bool usesGame = options.snapshotFilename.empty() || options.command.find("training") != std::string::npos;
+    int result {success};
+    std::vector<double> times;
+
+    try
+    {
+        if(usesGame && options.gameFolder.empty())
+            options.gameFolder = getGameFolder(exePath);
+
+        if(!options.gameFolder.empty() && options.gameFolder.find_last_of("/\\") != options.gameFolder.size() - 1)
+            options.gameFolder += '/';
+
+        std::function<void()> run;
+
+        if(options.command == "load" || options.command == "apply")
+            run = [&]
+            {
+                if(options.snapshotFilename.empty())
+                    challenge.openProcess(options.gameFolder + gameName);
+                else
+                    challenge.openSnapshot(options.snapshotFilename);
+
+                // the budgets are counted from the start of each load
+                challenge.getScanControl().start();
+                challenge.load();
+
+                if(options.command == "apply")
+                    challenge.updateRules(options.hasSeed ? options.seed : challenge.getSeed(),
+                        options.hasGoal ? options.goal : challenge.getGoal(),
+                        options.hasLimit ? options.limit : challenge.getLimit());
+            };
+
+        else if(options.command == "check-training")
+            run = [&]
+            {
+                Bundle bundle(options.gameFolder, bundleName);
+                result = bundle.checkTrainingRoom() ? success : notInstalled;
+            };
+
+        else
+            run = [&]
+            {
+                Bundle bundle(options.gameFolder, bundleName);
+                bundle.installTrainingRoom(options.command == "install-training");
+            };
+
+        for(unsigned i = 0; i < options.repeat; ++i)
+        {
+            const auto start = hrClock::now();
+            run();
+            const std::chrono::duration<double> elapsed = hrClock::now() - start;
+            times.push_back(elapsed.count());
+        }
+    }
+    catch(const std::exception &e)
+    {
+        cout.rdbuf(outputBuffer);
+        cerr << "Error: " << e.what() << endl;
+
+        if(options.printStats)
+            challenge.getStats().print(cerr);
+
+        return failure;
+    }
+
+    cout.rdbuf(outputBuffer);
+
+    // the format set by the progress messages is not reused
+    std::ostream output(outputBuffer);
+    if(options.command == "load" || options.command == "apply")
+        printChallenge(output, challenge, options.printStats);
+
+    if(options.repeat > 1)
+        printLatencies(times);
+
+    return result;
+}
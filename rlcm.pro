@@ -20,23 +20,69 @@ QMAKE_CXXFLAGS += -Winit-self -Wnon-virtual-dtor -Wold-style-cast -Woverloaded-v
 QMAKE_CXXFLAGS += -Wwrite-strings -Wpointer-arith -Wcast-qual -Wlogical-op
 QMAKE_CXXFLAGS += -Wuninitialized -fexceptions
 
-LIBS += -lpsapi
+win32 {
+    LIBS += -lpsapi
+    SOURCES += src/WindowsProcess.cpp
+}
+
+unix {
+    SOURCES += src/LinuxProcess.cpp
+}
 
-SOURCES += src/Bundle.cpp \
+SOURCES += src/AddressCache.cpp \
+    src/Bundle.cpp \
+    src/ByteSearch.cpp \
     src/Challenge.cpp \
+    src/ChallengeGroup.cpp \
+    src/ChallengeWatcher.cpp \
     src/Clock.cpp \
+    src/GameFolder.cpp \
+    src/Json.cpp \
     src/main.cpp \
     src/MainFrame.cpp \
+    src/OccurrenceIndex.cpp \
     src/OutputStream.cpp \
+    src/PatternSet.cpp \
+    src/PointerChain.cpp \
     src/Process.cpp \
-    src/SpinBox.cpp
+    src/ProcessRegistry.cpp \
+    src/RegionStats.cpp \
+    src/ScanControl.cpp \
+    src/ScanPool.cpp \
+    src/ScanStats.cpp \
+    src/Signature.cpp \
+    src/Snapshot.cpp \
+    src/SpinBox.cpp \
+    src/WriteTransaction.cpp
 
-HEADERS += src/Bundle.hpp \
+HEADERS += src/AddressCache.hpp \
+    src/Bundle.hpp \
+    src/ByteOrder.hpp \
+    src/ByteSearch.hpp \
     src/Challenge.hpp \
+    src/ChallengeGroup.hpp \
+    src/ChallengeLayout.hpp \
+    src/ChallengeWatcher.hpp \
     src/Clock.hpp \
+    src/GameFolder.hpp \
+    src/Hash.hpp \
+    src/Json.hpp \
     src/MainFrame.hpp \
+    src/OccurrenceIndex.hpp \
     src/OutputStream.hpp \
+    src/PatternSet.hpp \
+    src/PointerChain.hpp \
     src/Process.hpp \
-    src/SpinBox.hpp
+    src/ProcessBackend.hpp \
+    src/ProcessRegistry.hpp \
+    src/RegionStats.hpp \
+    src/ScanCache.hpp \
+    src/ScanControl.hpp \
+    src/ScanPool.hpp \
+    src/ScanStats.hpp \
+    src/Signature.hpp \
+    src/Snapshot.hpp \
+    src/SpinBox.hpp \
+    src/WriteTransaction.hpp
 
 RESOURCES += data/rsrc.qrc
@@ -0,0 +1,95 @@
+#include "AddressCache.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+    bool sameKey(const CachedAddresses &a, const CachedAddresses &b) noexcept
+    {
+        return a.processId == b.processId && a.startTime == b.startTime
+            && a.moduleFingerprint == b.moduleFingerprint;
+    }
+}
+
+void AddressCache::open(const std::string &filename) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_filename = filename;
+    m_entries.clear();
+
+    std::ifstream ifs(filename);
+
+    // one entry per line, in hexadecimal notation:
+    // processId startTime moduleFingerprint seedAddress address0 address1
+    std::string line;
+    while(std::getline(ifs, line) && m_entries.size() < maxEntryCount)
+    {
+        std::istringstream stream(line);
+        CachedAddresses entry;
+        stream >> std::hex >> entry.processId >> entry.startTime >> entry.moduleFingerprint
+            >> entry.seedAddress >> entry.addresses[0] >> entry.addresses[1];
+
+        if(stream)
+            m_entries.push_back(entry);
+    }
+}
+
+bool AddressCache::find(CachedAddresses &entry) const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = std::find_if(m_entries.begin(), m_entries.end(),
+        [&entry](const CachedAddresses &e){ return sameKey(e, entry); });
+
+    if(it == m_entries.end())
+        return false;
+
+    entry = *it;
+    return true;
+}
+
+void AddressCache::store(const CachedAddresses &entry) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+        [&entry](const CachedAddresses &e){ return sameKey(e, entry); }), m_entries.end());
+
+    m_entries.insert(m_entries.begin(), entry);
+    if(m_entries.size() > maxEntryCount)
+        m_entries.resize(maxEntryCount);
+
+    save();
+}
+
+void AddressCache::remove(const CachedAddresses &entry) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto size = m_entries.size();
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+        [&entry](const CachedAddresses &e){ return sameKey(e, entry); }), m_entries.end());
+
+    if(m_entries.size() != size)
+        save();
+}
+
+void AddressCache::save() const noexcept
+{
+    if(m_filename.empty())
+        return;
+
+    std::ofstream ofs(m_filename, std::ios::out | std::ios::trunc);
+    ofs << std::hex;
+
+    for(const auto &entry : m_entries)
+        ofs << entry.processId << ' ' << entry.startTime << ' ' << entry.moduleFingerprint << ' '
+            << entry.seedAddress << ' ' << entry.addresses[0] << ' ' << entry.addresses[1] << '\n';
+
+    if(!ofs)
+        std::cerr << "Warning: Failed to save challenge addresses into file \"" << m_filename << "\"!" << std::endl;
+}
@@ -0,0 +1,58 @@
+#ifndef ADDRESSCACHE_H
+#define ADDRESSCACHE_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ProcessBackend.hpp"
+
+// the addresses of the challenge found in a given launch of the game
+struct CachedAddresses
+{
+    // key
+    unsigned processId {0};
+    std::uint64_t startTime {0};
+    std::uint64_t moduleFingerprint {0};
+
+    Address seedAddress {0};
+    std::array<Address, 2> addresses {{0, 0}};
+};
+
+// Remembers the challenge addresses of the last game launches, in memory and
+// in a file, so that the next loads only have to check them again instead of
+// scanning the whole process memory.
+// It can be shared by the challenges of several game instances.
+class AddressCache
+{
+    public:
+        // loads the entries saved into 'filename', the next entries are saved into it too
+        // a missing or corrupted file is considered empty
+        void open(const std::string &filename) noexcept;
+
+        // fills the addresses of 'entry' if an entry has the same key
+        // returns false if no entry matches
+        bool find(CachedAddresses &entry) const noexcept;
+
+        // adds or replaces the entry having the same key, and saves the file
+        void store(const CachedAddresses &entry) noexcept;
+
+        // removes the entry having the same key, and saves the file
+        void remove(const CachedAddresses &entry) noexcept;
+
+        // the oldest entries are dropped beyond this count
+        static const std::size_t maxEntryCount {16};
+
+    private:
+        void save() const noexcept;
+
+        mutable std::mutex m_mutex;
+        std::string m_filename;
+
+        // most recent first
+        std::vector<CachedAddresses> m_entries;
+};
+
+#endif // ADDRESSCACHE_H
@@ -8,11 +8,13 @@
 #include <stdexcept>
 #include <limits>
 #include <iterator>
+#include <cstdint>
 
 #include <QFile>
 
-using Long = long int;
-using LongLong = long long int;
+// the bundle stores 32 and 64 bits integers, whatever the platform is
+using Long = std::int32_t;
+using LongLong = std::int64_t;
 
 struct FileInfo
 {
@@ -0,0 +1,89 @@
+#ifndef BYTEORDER_H
+#define BYTEORDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#ifdef _MSC_VER
+#include <stdlib.h>
+#endif
+
+// the computer and the game are little endian, some values of the game are stored in big endian
+enum class Endianness { Big, Little };
+
+inline std::uint8_t byteSwap(std::uint8_t value) noexcept
+{
+    return value;
+}
+
+inline std::uint16_t byteSwap(std::uint16_t value) noexcept
+{
+#ifdef _MSC_VER
+    return _byteswap_ushort(value);
+#else
+    return __builtin_bswap16(value);
+#endif
+}
+
+inline std::uint32_t byteSwap(std::uint32_t value) noexcept
+{
+#ifdef _MSC_VER
+    return _byteswap_ulong(value);
+#else
+    return __builtin_bswap32(value);
+#endif
+}
+
+inline std::uint64_t byteSwap(std::uint64_t value) noexcept
+{
+#ifdef _MSC_VER
+    return _byteswap_uint64(value);
+#else
+    return __builtin_bswap64(value);
+#endif
+}
+
+// the unsigned integer which has 'Size' bytes, used to swap the bytes of any value
+template<std::size_t Size> struct UnsignedOfSize;
+template<> struct UnsignedOfSize<1> { using Type = std::uint8_t; };
+template<> struct UnsignedOfSize<2> { using Type = std::uint16_t; };
+template<> struct UnsignedOfSize<4> { using Type = std::uint32_t; };
+template<> struct UnsignedOfSize<8> { using Type = std::uint64_t; };
+
+// decodes the value stored with the given endianness at 'data', which doesn't need to be aligned
+template<typename T> T decodeValue(const char *data, Endianness endianness) noexcept
+{
+    static_assert(std::is_arithmetic<T>::value, "only arithmetic values can be decoded");
+
+    typename UnsignedOfSize<sizeof(T)>::Type bits;
+    std::memcpy(&bits, data, sizeof(T));
+    if(endianness == Endianness::Big)
+        bits = byteSwap(bits);
+
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+}
+
+// stores 'value' with the given endianness at 'data', which doesn't need to be aligned
+template<typename T> void encodeValue(T value, Endianness endianness, char *data) noexcept
+{
+    static_assert(std::is_arithmetic<T>::value, "only arithmetic values can be encoded");
+
+    typename UnsignedOfSize<sizeof(T)>::Type bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    if(endianness == Endianness::Big)
+        bits = byteSwap(bits);
+
+    std::memcpy(data, &bits, sizeof(T));
+}
+
+// converts a value read with the given endianness to the endianness of the computer (little endian)
+template<typename T> T toHostEndianness(T value, Endianness endianness) noexcept
+{
+    return decodeValue<T>(reinterpret_cast<const char*>(&value), endianness);
+}
+
+#endif // BYTEORDER_H
@@ -0,0 +1,282 @@
+#include "ByteSearch.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    #define BYTESEARCH_X86 1
+    #include <immintrin.h>
+#else
+    #define BYTESEARCH_X86 0
+#endif
+
+namespace
+{
+    using SearchFunction = const char* (*)(const char*, const char*, const char*, std::size_t);
+
+    // the vectorized kernels of searchAnyByte() only handle small byte sets
+    const std::size_t maxAnyByteCount {8};
+
+    // compares the bytes located between the first and the last one of the pattern
+    inline bool matchesInner(const char *data, const char *pattern, std::size_t length) noexcept
+    {
+        return length < 3 || std::memcmp(data + 1, pattern + 1, length - 2) == 0;
+    }
+
+    const char* searchScalar(const char *first, const char *last, const char *pattern, std::size_t length)
+    {
+        return std::search(first, last, pattern, pattern + length);
+    }
+
+    const char* searchBackwardsScalar(const char *first, const char *last, const char *pattern, std::size_t length)
+    {
+        return std::find_end(first, last, pattern, pattern + length);
+    }
+
+    const char* searchAnyByteScalar(const char *first, const char *last, const char *bytes, std::size_t count)
+    {
+        return std::find_first_of(first, last, bytes, bytes + count);
+    }
+
+#if BYTESEARCH_X86
+    __attribute__((target("sse2")))
+    const char* searchSse2(const char *first, const char *last, const char *pattern, std::size_t length)
+    {
+        const auto size = static_cast<std::size_t>(last - first);
+        if(length == 0 || length > size)
+            return searchScalar(first, last, pattern, length);
+
+        const auto firstByte = _mm_set1_epi8(pattern[0]);
+        const auto lastByte = _mm_set1_epi8(pattern[length - 1]);
+
+        std::size_t i {0};
+        for(; i + length + 15 <= size; i += 16)
+        {
+            const auto blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+            const auto blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i + length - 1));
+
+            auto mask = static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(blockFirst, firstByte), _mm_cmpeq_epi8(blockLast, lastByte))));
+
+            while(mask != 0)
+            {
+                const auto position = i + __builtin_ctz(mask);
+                if(matchesInner(first + position, pattern, length))
+                    return first + position;
+
+                mask &= mask - 1;
+            }
+        }
+
+        return searchScalar(first + i, last, pattern, length);
+    }
+
+    __attribute__((target("sse2")))
+    const char* searchBackwardsSse2(const char *first, const char *last, const char *pattern, std::size_t length)
+    {
+        const auto size = static_cast<std::size_t>(last - first);
+        if(length == 0 || length + 15 > size)
+            return searchBackwardsScalar(first, last, pattern, length);
+
+        const auto firstByte = _mm_set1_epi8(pattern[0]);
+        const auto lastByte = _mm_set1_epi8(pattern[length - 1]);
+
+        // positions [end, size - length] are tested before the loop by the scalar search
+        auto end = size - length + 1;
+        const auto tail = (end % 16);
+        auto it = searchBackwardsScalar(first + end - tail, last, pattern, length);
+        if(it != last)
+            return it;
+
+        for(end -= tail; end >= 16; end -= 16)
+        {
+            const auto i = end - 16;
+            const auto blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+            const auto blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i + length - 1));
+
+            auto mask = static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(blockFirst, firstByte), _mm_cmpeq_epi8(blockLast, lastByte))));
+
+            while(mask != 0)
+            {
+                const auto bit = 31 - __builtin_clz(mask);
+                if(matchesInner(first + i + bit, pattern, length))
+                    return first + i + bit;
+
+                mask &= ~(1u << bit);
+            }
+        }
+
+        return last;
+    }
+
+    __attribute__((target("sse2")))
+    const char* searchAnyByteSse2(const char *first, const char *last, const char *bytes, std::size_t count)
+    {
+        if(count == 0 || count > maxAnyByteCount)
+            return searchAnyByteScalar(first, last, bytes, count);
+
+        __m128i values[maxAnyByteCount];
+        for(std::size_t j = 0; j < count; ++j)
+            values[j] = _mm_set1_epi8(bytes[j]);
+
+        for(; last - first >= 16; first += 16)
+        {
+            const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+
+            auto equal = _mm_cmpeq_epi8(block, values[0]);
+            for(std::size_t j = 1; j < count; ++j)
+                equal = _mm_or_si128(equal, _mm_cmpeq_epi8(block, values[j]));
+
+            const auto mask = static_cast<unsigned>(_mm_movemask_epi8(equal));
+            if(mask != 0)
+                return first + __builtin_ctz(mask);
+        }
+
+        return searchAnyByteScalar(first, last, bytes, count);
+    }
+
+    __attribute__((target("avx2")))
+    const char* searchAvx2(const char *first, const char *last, const char *pattern, std::size_t length)
+    {
+        const auto size = static_cast<std::size_t>(last - first);
+        if(length == 0 || length > size)
+            return searchScalar(first, last, pattern, length);
+
+        const auto firstByte = _mm256_set1_epi8(pattern[0]);
+        const auto lastByte = _mm256_set1_epi8(pattern[length - 1]);
+
+        std::size_t i {0};
+        for(; i + length + 31 <= size; i += 32)
+        {
+            const auto blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+            const auto blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i + length - 1));
+
+            auto mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, firstByte), _mm256_cmpeq_epi8(blockLast, lastByte))));
+
+            while(mask != 0)
+            {
+                const auto position = i + __builtin_ctz(mask);
+                if(matchesInner(first + position, pattern, length))
+                    return first + position;
+
+                mask &= mask - 1;
+            }
+        }
+
+        return searchSse2(first + i, last, pattern, length);
+    }
+
+    __attribute__((target("avx2")))
+    const char* searchBackwardsAvx2(const char *first, const char *last, const char *pattern, std::size_t length)
+    {
+        const auto size = static_cast<std::size_t>(last - first);
+        if(length == 0 || length + 31 > size)
+            return searchBackwardsSse2(first, last, pattern, length);
+
+        const auto firstByte = _mm256_set1_epi8(pattern[0]);
+        const auto lastByte = _mm256_set1_epi8(pattern[length - 1]);
+
+        auto end = size - length + 1;
+        const auto tail = (end % 32);
+        auto it = searchBackwardsScalar(first + end - tail, last, pattern, length);
+        if(it != last)
+            return it;
+
+        for(end -= tail; end >= 32; end -= 32)
+        {
+            const auto i = end - 32;
+            const auto blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+            const auto blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i + length - 1));
+
+            auto mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, firstByte), _mm256_cmpeq_epi8(blockLast, lastByte))));
+
+            while(mask != 0)
+            {
+                const auto bit = 31 - __builtin_clz(mask);
+                if(matchesInner(first + i + bit, pattern, length))
+                    return first + i + bit;
+
+                mask &= ~(1u << bit);
+            }
+        }
+
+        return last;
+    }
+
+    __attribute__((target("avx2")))
+    const char* searchAnyByteAvx2(const char *first, const char *last, const char *bytes, std::size_t count)
+    {
+        if(count == 0 || count > maxAnyByteCount)
+            return searchAnyByteScalar(first, last, bytes, count);
+
+        __m256i values[maxAnyByteCount];
+        for(std::size_t j = 0; j < count; ++j)
+            values[j] = _mm256_set1_epi8(bytes[j]);
+
+        for(; last - first >= 32; first += 32)
+        {
+            const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+
+            auto equal = _mm256_cmpeq_epi8(block, values[0]);
+            for(std::size_t j = 1; j < count; ++j)
+                equal = _mm256_or_si256(equal, _mm256_cmpeq_epi8(block, values[j]));
+
+            const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(equal));
+            if(mask != 0)
+                return first + __builtin_ctz(mask);
+        }
+
+        return searchAnyByteSse2(first, last, bytes, count);
+    }
+#endif
+
+    struct Kernel
+    {
+        SearchFunction search;
+        SearchFunction searchBackwards;
+        SearchFunction searchAnyByte;
+        const char *name;
+    };
+
+    const Kernel& getKernel() noexcept
+    {
+        static const Kernel kernel = []
+        {
+#if BYTESEARCH_X86
+            __builtin_cpu_init();
+
+            if(__builtin_cpu_supports("avx2"))
+                return Kernel{searchAvx2, searchBackwardsAvx2, searchAnyByteAvx2, "avx2"};
+
+            if(__builtin_cpu_supports("sse2"))
+                return Kernel{searchSse2, searchBackwardsSse2, searchAnyByteSse2, "sse2"};
+#endif
+            return Kernel{searchScalar, searchBackwardsScalar, searchAnyByteScalar, "scalar"};
+        }();
+
+        return kernel;
+    }
+}
+
+const char* searchBytes(const char *first, const char *last, const char *pattern, std::size_t length) noexcept
+{
+    return getKernel().search(first, last, pattern, length);
+}
+
+const char* searchBytesBackwards(const char *first, const char *last, const char *pattern, std::size_t length) noexcept
+{
+    return getKernel().searchBackwards(first, last, pattern, length);
+}
+
+const char* searchAnyByte(const char *first, const char *last, const char *bytes, std::size_t count) noexcept
+{
+    return getKernel().searchAnyByte(first, last, bytes, count);
+}
+
+const char* getByteSearchKernel() noexcept
+{
+    return getKernel().name;
+}
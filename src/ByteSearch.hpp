@@ -0,0 +1,27 @@
+#ifndef BYTESEARCH_H
+#define BYTESEARCH_H
+
+#include <cstddef>
+
+// Byte pattern search kernels used to scan the process memory.
+// The vectorized kernels compare the first and the last byte of the pattern
+// against 16 (SSE2) or 32 (AVX2) positions at once and only compare the whole
+// pattern on the positions where both bytes match. The best kernel supported
+// by the CPU is selected the first time one of these functions is called.
+
+// returns a pointer to the first occurrence of 'pattern' in [first, last)
+// if the pattern is not found, 'last' is returned
+const char* searchBytes(const char *first, const char *last, const char *pattern, std::size_t length) noexcept;
+
+// returns a pointer to the last occurrence of 'pattern' in [first, last)
+// if the pattern is not found, 'last' is returned
+const char* searchBytesBackwards(const char *first, const char *last, const char *pattern, std::size_t length) noexcept;
+
+// returns a pointer to the first byte of [first, last) which is equal to one of the 'count' given bytes
+// if no such byte is found, 'last' is returned
+const char* searchAnyByte(const char *first, const char *last, const char *bytes, std::size_t count) noexcept;
+
+// returns the name of the selected kernel ("avx2", "sse2" or "scalar")
+const char* getByteSearchKernel() noexcept;
+
+#endif // BYTESEARCH_H
@@ -1,8 +1,104 @@
 #include "Challenge.hpp"
 
+#include <cstring>
+#include <fstream>
+#include <map>
+
+#include "ChallengeLayout.hpp"
+#include "Clock.hpp"
+#include "WriteTransaction.hpp"
+
 using std::cout;
+using std::cerr;
 using std::endl;
 
+namespace
+{
+    // the countdown filenames are searched with their null terminator
+    // so that only whole filenames are matched
+    enum Anchor { Countdown, ShaolinCountdown, IsgExtension };
+    const PatternSet anchors({std::string("countdown.act", 14),
+        std::string("countdown_shaolin.act", 22), ".isg"});
+
+    // 01 00 00 00   XX XX XX XX   00 00 00 00   00 00 00 00 'str'
+    // (assuming XX is one byte of the seed and 'str' is "countdown.act")
+    const Signature countdownSignature(
+        "01 00 00 00 ?? ?? ?? ?? 00 00 00 00 00 00 00 00");
+
+    // XX XX XX XX   ?? ?? ?? ??   ?? ?? ?? ??   ?? ?? ?? ??
+    // ?? ?? ?? ??   ?? ?? ?? ??   ?? ?? ?? ??   ?? ?? ?? ??
+    // ?? ?? ?? ??   ?? ?? ?? ??   ?? ?? ?? ??   ?? ?? ?? ??
+    // 02 00 00 00   02 00 00 00   ?? ?? ?? ??   ?? ?? ?? ??
+    // 00 00 00 00   01 00 00 00   ?? ?? ?? ??   ?? ?? ?? ??
+    // ?? ?? ?? ??   00 00 00 00   ?? ?? ?? ??   00 00 00 00
+    // 00 00 00 00   ?? ?? ?? ??   ?? ?? ?? ??   00 00 00 00
+    // ?? ?? ?? ??   'str'
+    // (assuming XX is one byte of the seed, ?? is an unknown byte and 'str' is "countdown_shaolin.act")
+    const Signature shaolinSignature(
+        "02 00 00 00 02 00 00 00 ?? ?? ?? ?? ?? ?? ?? ?? "
+        "00 00 00 00 01 00 00 00 ?? ?? ?? ?? ?? ?? ?? ?? "
+        "?? ?? ?? ?? 00 00 00 00 ?? ?? ?? ?? 00 00 00 00 "
+        "00 00 00 00 ?? ?? ?? ?? ?? ?? ?? ?? 00 00 00 00 "
+        "?? ?? ?? ??");
+
+    using RegularCountdown = CountdownLayout<CountdownKind::Regular>;
+    using DojoCountdown = CountdownLayout<CountdownKind::Dojo>;
+
+    // a structure of the rules, read at once
+    using RulesBlock = std::array<char, RulesLayout::size>;
+
+    // the seed of 'CountdownSeed' or 'RulesLayout', read alone
+    using SeedBlock = std::array<char, RulesLayout::Seed::size>;
+
+    // the ISG filename is "challenge_<level>_<event>_<difficulty>.isg"
+    Level parseLevel(const std::string &isg)
+    {
+        auto isgLevel = isg.substr(0, isg.find_last_of('_'));
+        isgLevel = isgLevel.substr(0, isgLevel.find_last_of('_'));
+
+        if(isgLevel == "challenge_spikyroad")
+            return Level::Pit;
+
+        if(isgLevel == "challenge_run")
+            return Level::LotLD;
+
+        if(isgLevel == "challenge_goingup")
+            return Level::Tower;
+
+        if(isgLevel == "challenge_drc_castle")
+            return Level::Murfy;
+
+        if(isgLevel == "challenge_shaolin")
+            return Level::Dojo;
+
+        return Level::Unknown;
+    }
+
+    Difficulty parseDifficulty(const std::string &isg)
+    {
+        const auto isgDifficulty = isg.substr(isg.find_last_of('_') + 1, 6);
+
+        if(isgDifficulty == "normal")
+            return Difficulty::Normal;
+
+        if(isgDifficulty == "expert")
+            return Difficulty::Expert;
+
+        return Difficulty::Unknown;
+    }
+
+    bool isKnownIsg(const std::string &isg)
+    {
+        return parseLevel(isg) != Level::Unknown && parseDifficulty(isg) != Difficulty::Unknown;
+    }
+}
+
+unsigned ChallengeCandidate::getScore() const noexcept
+{
+    // the seed copies weigh more than the other criteria together
+    return (seedCopiesMatch ? 4u : 0u) + (isgValid ? 2u : 0u) + (likelyRegion ? 1u : 0u);
+}
+
 Challenge::Challenge()
 {
 }
@@ -16,161 +112,640 @@ void Challenge::openProcess(const std::string programFilename)
 {
     cout << endl;
     m_process.open(programFilename);
+    m_occurrences.clear();
+}
+
+void Challenge::openSnapshot(const std::string &filename)
+{
+    cout << endl;
+    m_process.openSnapshot(filename);
+    m_occurrences.clear();
+}
+
+void Challenge::openProcess(std::shared_ptr<ProcessBackend> backend)
+{
+    cout << endl;
+    m_process.open(std::move(backend));
+    m_occurrences.clear();
+}
+
+void Challenge::saveSnapshot(const std::string &filename)
+{
+    cout << endl;
+    m_process.saveSnapshot(filename);
+}
+
+void Challenge::setAddressCacheFile(const std::string &filename) noexcept
+{
+    m_addressCache->open(filename);
+}
+
+void Challenge::setRegionStatsFile(const std::string &filename) noexcept
+{
+    m_regionStats->open(filename);
+}
+
+void Challenge::setPointerChainFile(const std::string &filename) noexcept
+{
+    m_pointerChains.clear();
+
+    std::ifstream ifs(filename);
+    std::string line;
+
+    for(unsigned lineNumber = 1; std::getline(ifs, line); ++lineNumber)
+    {
+        const auto first = line.find_first_not_of(" \t\r");
+        if(first == std::string::npos || line[first] == '#')
+            continue;
+
+        std::istringstream stream(line);
+        std::uint64_t fingerprint;
+        std::string target, chainStr;
+
+        stream >> std::hex >> fingerprint >> target;
+        std::getline(stream, chainStr);
+
+        try
+        {
+            if(target.empty())
+                throw std::invalid_argument("Malformed line.");
+
+            const auto chain = PointerChain::parse(chainStr);
+
+            auto chains = std::find_if(m_pointerChains.begin(), m_pointerChains.end(),
+                [fingerprint](const ChallengeChains &c){ return c.moduleFingerprint == fingerprint; });
+
+            if(chains == m_pointerChains.end())
+            {
+                m_pointerChains.emplace_back();
+                chains = m_pointerChains.end() - 1;
+                chains->moduleFingerprint = fingerprint;
+            }
+
+            if(target == "seed")
+                chains->seed = chain;
+            else if(target == "address0")
+                chains->addresses[0] = chain;
+            else if(target == "address1")
+                chains->addresses[1] = chain;
+            else
+                throw std::invalid_argument("Unknown target \"" + target + "\".");
+        }
+        catch(const std::exception &e)
+        {
+            cerr << "Warning: Ignoring line " << std::dec << lineNumber << " of \"" << filename << "\": " << e.what() << endl;
+        }
+    }
+}
+
+void Challenge::shareCaches(const Challenge &other) noexcept
+{
+    m_addressCache = other.m_addressCache;
+    m_regionStats = other.m_regionStats;
+}
+
+void Challenge::setScanThreadCount(unsigned count) noexcept
+{
+    m_process.setScanThreadCount(count);
+}
+
+unsigned Challenge::getProcessId() const noexcept
+{
+    return m_process.getProcessId();
 }
 
 void Challenge::load()
 {
     cout << endl << "Loading running challenge:" << endl;
+
+    auto &stats = m_process.getStats();
+    stats.reset();
+
+    std::ostringstream fingerprint;
+    fingerprint << std::hex << m_process.getModuleFingerprint();
+
+    stats.setProperty("module", m_process.getCurrentModuleName());
+    stats.setProperty("moduleFingerprint", fingerprint.str());
+    stats.setProperty("scanThreadCount", std::to_string(m_process.getScanThreadCount()));
+    stats.setProperty("scanBlockSize", std::to_string(m_process.getScanBlockSize()));
+
     findAddresses();
-    readRules();
+
+    Clock clock;
+    const bool rulesRead = readRules(m_addresses[0]);
+    stats.addPhase("Rules", clock.elapsed());
+
+    if(!rulesRead)
+        throw std::runtime_error("Failed to load challenge! (Challenge rules can't be read.)");
+
+    // the addresses found without scanning are the only candidate
+    if(m_candidates.empty())
+        m_candidates.push_back(makeCandidate());
+}
+
+ScanStats& Challenge::getStats() noexcept
+{
+    return m_process.getStats();
+}
+
+ScanControl& Challenge::getScanControl() noexcept
+{
+    return m_process.getScanControl();
 }
 
 void Challenge::findAddresses()
 {
-    Address address {0};
-    bool isDojo;
+    m_candidates.clear();
+    m_selectedCandidate = 0;
 
-    cout << "Searching first address in process memory... " << endl;
+    CachedAddresses cached;
+    cached.processId = m_process.getProcessId();
+    cached.startTime = m_process.getStartTime();
+    cached.moduleFingerprint = m_process.getModuleFingerprint();
 
-    while(true)
+    // the game launches which can't be identified are always scanned
+    const bool cacheable = cached.startTime != 0 && cached.moduleFingerprint != 0;
+
+    auto &stats = m_process.getStats();
+    Clock clock;
+
+    if(cacheable && m_addressCache->find(cached))
     {
-        address = m_process.findString("countdown", address);
-        if(address == Process::npos)
-            throw std::runtime_error("Failed to load challenge! (Challenge seed not found.)");
+        cout << "Checking cached addresses... " << endl;
 
-        auto countdownFilename = m_process.readString(address);
+        unsigned seed;
+        const bool valid = checkAddresses(cached.seedAddress, cached.addresses, seed);
+        stats.addPhase("Cached addresses", clock.reset());
 
-        std::string regexStr;
-        bool found = false;
-        if(countdownFilename == "countdown.act")
+        if(valid)
         {
-            // 01 00 00 00   XX XX XX XX   00 00 00 00   00 00 00 00 'str'
-            // (assuming XX is one byte of the seed and 'str' is the string that has been found)
-
-            regexStr = R"(\x01\x00{3}[\s\S]{4}\x00{8})";
-            isDojo = false;
-            found = true;
+            m_seed = seed;
+            m_seedAddress = cached.seedAddress;
+            m_addresses = cached.addresses;
 
+            cout << "> Seed: " << std::showbase << std::hex << m_seed << " (address: " << m_seedAddress << ")" << endl;
+            cout << "Success! (addresses: " << m_addresses[1] << ", " << m_addresses[0] << ")" << endl;
+            return;
         }
-        else if(countdownFilename == "countdown_shaolin.act")
+
+        cout << "Cached addresses are outdated." << endl;
+        m_addressCache->remove(cached);
+        stats.add(ScanStats::Retries);
+    }
+
+    const bool resolved = resolveAddresses(cached.moduleFingerprint);
+    stats.addPhase("Pointer chains", clock.reset());
+
+    if(!resolved)
+        scanAddresses();
+
+    storeAddresses();
+}
+
+void Challenge::storeAddresses()
+{
+    CachedAddresses cached;
+    cached.processId = m_process.getProcessId();
+    cached.startTime = m_process.getStartTime();
+    cached.moduleFingerprint = m_process.getModuleFingerprint();
+
+    if(cached.startTime == 0 || cached.moduleFingerprint == 0)
+        return;
+
+    cached.seedAddress = m_seedAddress;
+    cached.addresses = m_addresses;
+    m_addressCache->store(cached);
+}
+
+ChallengeCandidate Challenge::makeCandidate() const
+{
+    ChallengeCandidate candidate;
+    candidate.seedAddress = m_seedAddress;
+    candidate.addresses = m_addresses;
+    candidate.seed = m_seed;
+    candidate.isg = m_isg;
+    candidate.seedCopiesMatch = true;
+    candidate.isgValid = isKnownIsg(m_isg);
+
+    return candidate;
+}
+
+const std::vector<ChallengeCandidate>& Challenge::getCandidates() const noexcept
+{
+    return m_candidates;
+}
+
+std::size_t Challenge::getSelectedCandidate() const noexcept
+{
+    return m_selectedCandidate;
+}
+
+void Challenge::selectCandidate(std::size_t index)
+{
+    if(index >= m_candidates.size())
+        throw std::out_of_range("There is no such challenge structure.");
+
+    const auto &candidate = m_candidates[index];
+
+    cout << endl << "Selecting challenge structure " << std::dec << index + 1 << "... " << endl;
+
+    if(!candidate.seedCopiesMatch)
+        throw std::runtime_error("The copies of the seed differ in this structure, it doesn't hold the running challenge.");
+
+    // the current structure stays selected until the rules of the new one are read
+    unsigned seed;
+    if(!checkAddresses(candidate.seedAddress, candidate.addresses, seed))
+        throw std::runtime_error("This structure doesn't hold a challenge anymore, load the challenge again.");
+
+    if(!readRules(candidate.addresses[0]))
+        throw std::runtime_error("Failed to load challenge! (Challenge rules can't be read.)");
+
+    m_seed = seed;
+    m_seedAddress = candidate.seedAddress;
+    m_addresses = candidate.addresses;
+    m_selectedCandidate = index;
+
+    // the next load uses the chosen structure
+    storeAddresses();
+}
+
+bool Challenge::checkAddresses(Address seedAddress, const std::array<Address, 2> &addresses, unsigned &seed) noexcept
+{
+    // the countdown filename and its signature must still be next to the seed,
+    // the 3 copies of the seed must be equal and both structures must name the same ISG
+    // everything is read at once
+    const auto &countdownName = anchors.getPattern(Countdown);
+    const auto &shaolinName = anchors.getPattern(ShaolinCountdown);
+
+    std::array<char, 0x80> countdown, shaolin;
+    SeedBlock seedData;
+    std::array<RulesBlock, 2> rules;
+
+    std::array<ReadRequest, 5> requests {{
+        {seedAddress + RegularCountdown::nameOffset - countdownSignature.size(), countdown.data(), countdownSignature.size() + countdownName.size()},
+        {seedAddress + DojoCountdown::nameOffset - shaolinSignature.size(), shaolin.data(), shaolinSignature.size() + shaolinName.size()},
+        {seedAddress, seedData.data(), seedData.size()},
+        {addresses[0], rules[0].data(), rules[0].size()},
+        {addresses[1], rules[1].data(), rules[1].size()}}};
+
+    // the result of each request is checked below
+    m_process.readBatch(requests);
+
+    auto matchesLayout = [](const ReadRequest &request, const Signature &signature, const std::string &name)
+    {
+        return request.success && signature.matches(request.buffer)
+            && std::equal(name.begin(), name.end(), request.buffer + signature.size());
+    };
+
+    const bool isDojo = matchesLayout(requests[1], shaolinSignature, shaolinName);
+    if(!isDojo && !matchesLayout(requests[0], countdownSignature, countdownName))
+        return false;
+
+    const auto layout = getCountdownOffsets(isDojo ? CountdownKind::Dojo : CountdownKind::Regular);
+    if(addresses[1] != seedAddress - layout.rulesOffset
+        || !std::all_of(requests.begin() + 2, requests.end(), [](const ReadRequest &r){ return r.success; }))
+        return false;
+
+    const auto countdownSeed = CountdownSeed::Seed::decode(seedData.data());
+    if(countdownSeed == 0x0 || RulesLayout::Seed::decode(rules[0].data()) != countdownSeed
+        || RulesLayout::Seed::decode(rules[1].data()) != countdownSeed)
+        return false;
+
+    const auto isg = RulesLayout::Isg::decode(rules[1].data());
+    if(isg.empty() || RulesLayout::Isg::decode(rules[0].data()) != isg)
+        return false;
+
+    seed = countdownSeed;
+    return true;
+}
+
+bool Challenge::resolveAddresses(std::uint64_t moduleFingerprint) noexcept
+{
+    auto chains = std::find_if(m_pointerChains.begin(), m_pointerChains.end(),
+        [moduleFingerprint](const ChallengeChains &c){ return c.moduleFingerprint == moduleFingerprint; });
+
+    if(moduleFingerprint == 0 || chains == m_pointerChains.end())
+        return false;
+
+    cout << "Resolving pointer chains... " << endl;
+
+    const auto seedAddress = m_process.resolvePointerChain(chains->seed);
+    const std::array<Address, 2> addresses {{m_process.resolvePointerChain(chains->addresses[0]),
+        m_process.resolvePointerChain(chains->addresses[1])}};
+
+    unsigned seed;
+    if(seedAddress == Process::npos || addresses[0] == Process::npos || addresses[1] == Process::npos
+        || !checkAddresses(seedAddress, addresses, seed))
+    {
+        cout << "Pointer chains don't lead to the challenge." << endl;
+        m_process.getStats().add(ScanStats::Retries);
+        return false;
+    }
+
+    m_seed = seed;
+    m_seedAddress = seedAddress;
+    m_addresses = addresses;
+
+    cout << "> Seed: " << std::showbase << std::hex << m_seed << " (address: " << m_seedAddress << ")" << endl;
+    cout << "Success! (addresses: " << m_addresses[1] << ", " << m_addresses[0] << ")" << endl;
+
+    return true;
+}
+
+void Challenge::scanAddresses()
+{
+    auto &stats = m_process.getStats();
+    Clock clock;
+
+    const auto regions = m_process.getRegions();
+    const auto likelyRegions = m_regionStats->getLikelyRegions(regions);
+
+    // the kinds of regions which held the challenge during the previous scans are searched first
+    bool found {false};
+    if(!likelyRegions.empty() && likelyRegions.size() < regions.size())
+    {
+        cout << "Searching challenge anchors in " << std::dec << likelyRegions.size() << " likely regions... " << endl;
+
+        m_occurrences.build(m_process, anchors, likelyRegions);
+        stats.addPhase("Likely regions scan", clock.reset());
+        m_process.getScanControl().check();
+
+        try
         {
-            // XX XX XX XX   ?? ?? ?? ??   ?? ?? ?? ??   ?? ?? ?? ??
-            // ?? ?? ?? ??   ?? ?? ?? ??   ?? ?? ?? ??   ?? ?? ?? ??
-            // ?? ?? ?? ??   ?? ?? ?? ??   ?? ?? ?? ??   ?? ?? ?? ??
-            // 02 00 00 00   02 00 00 00   ?? ?? ?? ??   ?? ?? ?? ??
-            // 00 00 00 00   01 00 00 00   ?? ?? ?? ??   ?? ?? ?? ??
-            // ?? ?? ?? ??   00 00 00 00   ?? ?? ?? ??   00 00 00 00
-            // 00 00 00 00   ?? ?? ?? ??   ?? ?? ?? ??   00 00 00 00
-            // ?? ?? ?? ??   'str'
-            // (assuming XX is one byte of the seed, ?? is an unknown byte and 'str' is the string that has been found)
-
-            regexStr = R"(\x02\x00{3}\x02\x00{3}[\s\S]{8}\x00{4}\x01\x00{3}[\s\S]{12}\x00{4}[\s\S]{4}\x00{8}[\s\S]{8}\x00{4})";
-            isDojo = true;
+            searchOccurrences(likelyRegions);
             found = true;
         }
+        catch(const std::exception &e)
+        {
+            m_process.getScanControl().check();
+            cout << e.what() << endl << "The challenge is not in the likely regions." << endl;
+            stats.add(ScanStats::Retries);
+        }
+
+        stats.addPhase("Likely regions search", clock.reset());
+    }
+
+    if(!found)
+    {
+        cout << "Searching challenge anchors in process memory... " << endl;
+
+        m_occurrences.build(m_process, anchors);
+        stats.addPhase("Full scan", clock.reset());
+        m_process.getScanControl().check();
+
+        searchOccurrences(likelyRegions);
+        stats.addPhase("Full search", clock.reset());
+    }
+
+    m_regionStats->record(regions, {m_seedAddress, m_addresses[0], m_addresses[1]});
+}
+
+void Challenge::searchOccurrences(const std::vector<MemoryRegion> &likelyRegions)
+{
+    cout << "Searching challenge structures in process memory... " << endl;
+
+    // the signatures preceding the countdown filenames are read at once
+    std::vector<ReadRequest> requests;
+    std::vector<std::size_t> offsets;
+    std::size_t bufferSize {0};
 
-        if(found)
+    for(auto anchor : {Countdown, ShaolinCountdown})
+    {
+        const auto &signature = anchor == ShaolinCountdown ? shaolinSignature : countdownSignature;
+
+        for(auto occurrence : m_occurrences.getOccurrences(anchor))
         {
-            const auto bufferSize = (isDojo ? 0x44 : 0x10);
-            if(m_process.searchRegex(std::regex(regexStr), address - bufferSize, bufferSize))
-                break;
+            ReadRequest request;
+            request.address = occurrence - signature.size();
+            request.length = signature.size();
+            requests.push_back(request);
+
+            offsets.push_back(bufferSize);
+            bufferSize += signature.size();
         }
-        ++address;
     }
 
-    address -= (isDojo ? 0x74 : 0x0C);
+    std::vector<char> signatures(bufferSize);
+    for(std::size_t i = 0; i < requests.size(); ++i)
+        requests[i].buffer = signatures.data() + offsets[i];
+
+    m_process.readBatch(requests.data(), requests.size());
+
+    // every countdown is a candidate, whatever its kind, in memory order
+    // (a request ends where its countdown filename starts)
+    std::vector<const ReadRequest*> sortedRequests;
+    for(const auto &request : requests)
+        sortedRequests.push_back(&request);
+
+    std::stable_sort(sortedRequests.begin(), sortedRequests.end(),
+        [](const ReadRequest *a, const ReadRequest *b){ return a->address + a->length < b->address + b->length; });
+
+    std::vector<ChallengeCandidate> candidates;
+    for(const auto *request : sortedRequests)
+    {
+        m_process.getStats().add(ScanStats::SignatureChecks);
+        const bool isDojo = request->length == shaolinSignature.size();
+
+        const auto &signature = isDojo ? shaolinSignature : countdownSignature;
+        if(!request->success || !signature.matches(request->buffer))
+            continue;
+
+        const auto layout = getCountdownOffsets(isDojo ? CountdownKind::Dojo : CountdownKind::Regular);
+
+        ChallengeCandidate candidate;
+        candidate.seedAddress = request->address + signature.size() - layout.nameOffset;
+        candidate.addresses[1] = candidate.seedAddress - layout.rulesOffset;
+        candidates.push_back(candidate);
+    }
+
+    if(candidates.empty())
+        throw std::runtime_error("Failed to load challenge! (Challenge seed not found.)");
+
+    // the seed of every candidate and the structure of the rules following it are read at once
+    std::vector<SeedBlock> seeds(candidates.size());
+    std::vector<RulesBlock> rules(candidates.size());
+
+    requests.clear();
+    for(std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        requests.push_back({candidates[i].seedAddress, seeds[i].data(), seeds[i].size()});
+        requests.push_back({candidates[i].addresses[1], rules[i].data(), rules[i].size()});
+    }
+
+    m_process.readBatch(requests.data(), requests.size());
+
+    // the candidates which can't hold a challenge are dropped, the reason of the last one is
+    // reported if none is left
+    std::string error;
+    std::vector<ChallengeCandidate> validCandidates;
+    std::map<std::pair<std::string, unsigned>, Address> firstAddresses;
+
+    for(std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        auto &candidate = candidates[i];
+
+        const auto failed = std::find_if(requests.begin() + 2 * i, requests.begin() + 2 * i + 2, [](const ReadRequest &r){ return !r.success; });
+        if(failed != requests.begin() + 2 * i + 2)
+        {
+            std::ostringstream os;
+            os << "Failed to read memory from process \"" << m_process.getCurrentModuleName() << "\" (at " << std::showbase << std::hex << failed->address << ").";
+            error = os.str();
+            continue;
+        }
+
+        candidate.seed = CountdownSeed::Seed::decode(seeds[i].data());
+        cout << "> Seed: " << std::showbase << std::hex << candidate.seed <<  " (address: " << candidate.seedAddress << ")" << endl;
+
+        if(candidate.seed == 0x0)
+        {
+            error = "Can't continue process with challenge seed: 00 00 00 00\nSeed might have been edited outside the game.";
+            continue;
+        }
+
+        candidate.isg = RulesLayout::Isg::decode(rules[i].data());
+        cout << "> ISG filename: " << candidate.isg << endl;
+        candidate.addresses[0] = Process::npos;
+
+        // the first address is searched with the seed of the countdown
+        // the stale copies of a challenge share it, so it is searched once
+        if(!candidate.isg.empty())
+        {
+            const auto key = std::make_pair(candidate.isg, candidate.seed);
+            if(!firstAddresses.count(key))
+                firstAddresses[key] = findFirstAddress(candidate.isg, candidate.seed);
+
+            candidate.addresses[0] = firstAddresses[key];
+        }
+
+        if(candidate.addresses[0] == Process::npos)
+        {
+            error = "Failed to load challenge! (ISG filename not found.)";
+            continue;
+        }
+
+        candidate.seedCopiesMatch = RulesLayout::Seed::decode(rules[i].data()) == candidate.seed;
+        candidate.isgValid = isKnownIsg(candidate.isg);
+
+        auto region = std::upper_bound(likelyRegions.begin(), likelyRegions.end(), candidate.addresses[1],
+            [](Address address, const MemoryRegion &r){ return address < r.base; });
+        candidate.likelyRegion = region != likelyRegions.begin() && candidate.addresses[1] < (region - 1)->end();
+
+        validCandidates.push_back(candidate);
+    }
 
-    m_seedAddress = address;
+    if(validCandidates.empty())
+        throw std::runtime_error(error);
 
-    m_process.setEndianness(Endianness::Big);
-    m_seed = m_process.readValue<unsigned>(address);
-    cout << "> Seed: " << std::showbase << std::hex << m_seed <<  " (address: " << m_seedAddress << ")" << endl;
+    // the most likely candidate is selected, the first one in memory if several are as likely
+    std::stable_sort(validCandidates.begin(), validCandidates.end(),
+        [](const ChallengeCandidate &a, const ChallengeCandidate &b){ return a.getScore() > b.getScore(); });
 
-    if(m_seed == 0x0)
-        throw std::runtime_error("Can't continue process with challenge seed: 00 00 00 00\nSeed might have been edited outside the game.");
+    cout << "Found " << std::dec << validCandidates.size() << " challenge structures:" << endl;
+    for(const auto &candidate : validCandidates)
+        cout << "> " << std::showbase << std::hex << candidate.addresses[1] << ", " << candidate.addresses[0]
+            << ": " << candidate.isg << " (score: " << std::dec << candidate.getScore() << ")" << endl;
 
-    address -= (isDojo ? 0x12C : 0x5F8);
-    auto tempSeed = m_process.readValue<unsigned>(address);
-    if(tempSeed != m_seed)
+    // a stale structure is never written into unless it is chosen explicitly
+    const auto &selected = validCandidates.front();
+    if(!selected.seedCopiesMatch)
     {
+        const auto i = static_cast<std::size_t>(std::find_if(candidates.begin(), candidates.end(),
+            [&selected](const ChallengeCandidate &c){ return c.seedAddress == selected.seedAddress; }) - candidates.begin());
+
         std::ostringstream os;
-        os << "Challenge seed might be corrupted: " << std::showbase << std::hex << m_seed << " != " << tempSeed << " (at " << address - 0x34 << ").";
+        os << "Challenge seed might be corrupted: " << std::showbase << std::hex << selected.seed << " != "
+            << RulesLayout::Seed::decode(rules[i].data()) << " (at " << selected.addresses[1] << ").";
         throw std::runtime_error(os.str());
     }
 
-    cout << "Success! (address: " << address << ")" << endl;
-    m_addresses[1] = address;
+    m_candidates = std::move(validCandidates);
+    m_selectedCandidate = 0;
+
+    m_seed = m_candidates[0].seed;
+    m_seedAddress = m_candidates[0].seedAddress;
+    m_addresses = m_candidates[0].addresses;
+
+    cout << "Success! (addresses: " << std::showbase << std::hex << m_addresses[1] << ", " << m_addresses[0] << ")" << endl;
+}
+
+Address Challenge::findFirstAddress(const std::string &isg, unsigned seed)
+{
+    const Address searchLimit {0x1000'0000};
+
+    // the ISG filename is looked for before 'searchLimit', the closest occurrence first
+    // it is found in the index if it holds an anchor (its extension)
+    if(m_occurrences.canFind(isg))
+    {
+        // the seed preceding every occurrence is read at once
+        const auto occurrences = m_occurrences.find(m_process, isg, RulesLayout::Isg::offset, searchLimit);
+        std::vector<char> seeds(occurrences.size() * RulesLayout::Seed::size);
+
+        std::vector<ReadRequest> requests;
+        for(std::size_t i = 0; i < occurrences.size(); ++i)
+            requests.push_back({occurrences[i] - RulesLayout::Isg::offset, seeds.data() + i * RulesLayout::Seed::size, RulesLayout::Seed::size});
 
-    auto isg = m_process.readString(address + 0x34);
-    cout << "> ISG filename: " << isg << endl;
+        m_process.readBatch(requests.data(), requests.size());
+
+        for(std::size_t i = occurrences.size(); i-- > 0;)
+        {
+            m_process.getStats().add(ScanStats::SignatureChecks);
+            if(requests[i].success && RulesLayout::Seed::decode(requests[i].buffer) == seed)
+                return requests[i].address;
+        }
 
-    address = 0x1000'0000;
+        return Process::npos;
+    }
 
-    cout << "Searching second address in process memory... " << endl;
+    Address address {searchLimit};
 
     while(true)
     {
         address = m_process.findString(isg, address, true);
+        m_process.getScanControl().check();
+
         if(address == Process::npos)
-            throw std::runtime_error("Failed to load challenge! (ISG filename not found.)");
+            return Process::npos;
 
-        if(m_process.readValue<unsigned>(address - 0x34) == m_seed)
-            break;
+        SeedBlock seedData;
+        if(m_process.readInto(address - RulesLayout::Isg::offset, seedData.data(), seedData.size())
+            && RulesLayout::Seed::decode(seedData.data()) == seed)
+            return address - RulesLayout::Isg::offset;
 
+        m_process.getStats().add(ScanStats::Retries);
         --address;
     }
-
-    address -= 0x34;
-
-    cout << "Success! (address: " << address << ")" << endl;
-    m_addresses[0] = address;
 }
 
-void Challenge::readRules() noexcept
+bool Challenge::readRules(Address address) noexcept
 {
     cout << "Getting challenge informations in process memory... " << endl;
 
-    auto isg = m_process.readString(m_addresses[0] + 0x34);
-
-    auto isgLevel = isg.substr(0, isg.find_last_of('_'));
-    auto isgEvent = isgLevel.substr(isgLevel.find_last_of('_') + 1);
-    isgLevel = isgLevel.substr(0, isgLevel.find_last_of('_'));
-    auto isgDifficulty = isg.substr(isg.find_last_of('_') + 1, 6);
-
-
-    if(isgLevel == "challenge_spikyroad")
-        m_level = Level::Pit;
+    // the whole structure is read at once
+    RulesBlock rules;
+    if(!m_process.readInto(address, rules.data(), rules.size()))
+        return false;
 
-    else if(isgLevel == "challenge_run")
-        m_level = Level::LotLD;
+    const auto isg = RulesLayout::Isg::decode(rules.data());
+    m_isg = isg;
 
-    else if(isgLevel == "challenge_goingup")
-        m_level = Level::Tower;
+    m_event = Event::Unknown;
 
-    else if(isgLevel == "challenge_drc_castle")
-        m_level = Level::Murfy;
+    auto isgEvent = isg.substr(0, isg.find_last_of('_'));
+    isgEvent = isgEvent.substr(isgEvent.find_last_of('_') + 1);
 
-    else if(isgLevel == "challenge_shaolin")
-        m_level = Level::Dojo;
 
+    m_level = parseLevel(isg);
     cout << "> Level: " << getLevelName() << endl;
 
 
-    if(isgDifficulty == "normal")
-        m_difficulty = Difficulty::Normal;
-
-    else if(isgDifficulty == "expert")
-        m_difficulty = Difficulty::Expert;
-
+    m_difficulty = parseDifficulty(isg);
     cout << "> Difficulty: " << getDifficultyName() << endl;
 
 
-    m_process.setEndianness(Endianness::Little);
-
-    m_goal = m_process.readValue<float>(m_addresses[0] + 0x0C);
+    m_goal = RulesLayout::Goal::decode(rules.data());
     cout << "> Goal: " << m_goal << endl;
 
-    m_limit = m_process.readValue<float>(m_addresses[0] + 0x10);
+    m_limit = RulesLayout::Limit::decode(rules.data());
     cout << "> Score limit: " << m_limit << endl;
 
     if(isgEvent == "default")
@@ -202,6 +777,7 @@ void Challenge::readRules() noexcept
     cout << "> Event: " << getEventName() << endl;
 
     cout << "Success!" << endl;
+    return true;
 }
 
 std::string Challenge::getLevelName() const noexcept
@@ -334,46 +910,96 @@ std::string Challenge::getLimitType() const noexcept
     return "";
 }
 
-void Challenge::updateRules(unsigned seed, float goal, float limit)
+ChallengeStatus Challenge::check() noexcept
 {
-    auto updateValue = [this](Address address, auto value)
+    std::array<SeedBlock, 2> seeds;
+    RulesBlock rules;
+
+    std::array<ReadRequest, 3> requests {{
+        {m_seedAddress, seeds[0].data(), seeds[0].size()},
+        {m_addresses[1], seeds[1].data(), seeds[1].size()},
+        {m_addresses[0], rules.data(), rules.size()}}};
+
+    bool unchanged = m_process.readBatch(requests);
+    if(unchanged)
     {
-        m_process.writeValue<decltype(value)>(address, value);
-        cout << "At " << std::hex << std::showbase << address << ": sucess!" << endl;
-    };
+        // the values are compared bitwise, so that a NaN doesn't look like a change
+        const auto goal = RulesLayout::Goal::decode(rules.data());
+        const auto limit = RulesLayout::Limit::decode(rules.data());
+
+        unchanged = CountdownSeed::Seed::decode(seeds[0].data()) == m_seed
+            && RulesLayout::Seed::decode(seeds[1].data()) == m_seed && RulesLayout::Seed::decode(rules.data()) == m_seed
+            && std::memcmp(&goal, &m_goal, sizeof(goal)) == 0 && std::memcmp(&limit, &m_limit, sizeof(limit)) == 0
+            && RulesLayout::Isg::decode(rules.data()) == m_isg;
+    }
+
+    if(unchanged)
+        return ChallengeStatus::Unchanged;
+
+    cout << endl << "Challenge has changed:" << endl;
+
+    unsigned seed;
+    if(!checkAddresses(m_seedAddress, m_addresses, seed) || !readRules(m_addresses[0]))
+    {
+        cout << "Challenge is lost." << endl;
+        return ChallengeStatus::Lost;
+    }
+
+    m_seed = seed;
+
+    return ChallengeStatus::Changed;
+}
+
+void Challenge::updateRules(unsigned seed, float goal, float limit)
+{
+    // every value is written at once, the game reading the structures in between
+    WriteTransaction transaction(m_process);
 
     cout << endl;
 
-    if(seed != m_seed)
+    const bool seedChanged = seed != m_seed;
+    const bool goalChanged = goal != m_goal && m_event != Event::Distance && m_event != Event::LumsDistance;
+    const bool limitChanged = limit != m_limit;
+
+    if(seedChanged)
     {
         cout << "Updating seed..." << endl;
-        m_process.setEndianness(Endianness::Big);
-        updateValue(m_seedAddress, seed);
-        updateValue(m_addresses[0], seed);
-        updateValue(m_addresses[1], seed);
+        transaction.writeField<CountdownSeed::Seed>(m_seedAddress, seed);
+        transaction.writeField<RulesLayout::Seed>(m_addresses[0], seed);
+        transaction.writeField<RulesLayout::Seed>(m_addresses[1], seed);
+    }
+
+    if(goalChanged)
+    {
+        cout << "Updating goal..." << endl;
+        transaction.writeField<RulesLayout::Goal>(m_addresses[0], goal);
+        transaction.writeField<RulesLayout::Goal>(m_addresses[1], goal);
+    }
 
+    if(limitChanged)
+    {
+        cout << "Updating score limit..." << endl;
+        transaction.writeField<RulesLayout::Limit>(m_addresses[0], limit);
+        transaction.writeField<RulesLayout::Limit>(m_addresses[1], limit);
+    }
+
+    transaction.commit();
+    cout << "Success! (" << std::dec << transaction.getWrittenAreaCount() << " areas written and verified)" << endl;
+
+    if(seedChanged)
+    {
         m_seed = seed;
         cout << "Seed has been updated successfully!" << endl;
     }
 
-    if(goal != m_goal && m_event != Event::Distance && m_event != Event::LumsDistance)
+    if(goalChanged)
     {
-        cout << "Updating goal..." << endl;
-        m_process.setEndianness(Endianness::Little);
-        updateValue(m_addresses[0] + 0x0C, goal);
-        updateValue(m_addresses[1] + 0x0C, goal);
-
         m_goal = goal;
         cout << "Goal has been updated successfully!" << endl;
     }
 
-    if(limit != m_limit)
+    if(limitChanged)
     {
-        cout << "Updating score limit..." << endl;
-        m_process.setEndianness(Endianness::Little);
-        updateValue(m_addresses[0] + 0x10, limit);
-        updateValue(m_addresses[1] + 0x10, limit);
-
         m_limit = limit;
         cout << "Score limit has been updated successfully!" << endl;
     }
@@ -2,6 +2,10 @@
 #define CHALLENGE_H
 
 #include "Process.hpp"
+#include "AddressCache.hpp"
+#include "OccurrenceIndex.hpp"
+#include "PointerChain.hpp"
+#include "RegionStats.hpp"
 
 enum class Level
 {
@@ -30,14 +34,92 @@ enum class Difficulty
     Unknown
 };
 
+// pointer chains leading to the challenge in a given build of the game
+struct ChallengeChains
+{
+    std::uint64_t moduleFingerprint {0};
+    PointerChain seed;
+    std::array<PointerChain, 2> addresses;
+};
+
+// a structure holding a challenge, found by 'Challenge::load'
+// stale copies and the challenges of the previous rounds stay in memory next to the running one
+struct ChallengeCandidate
+{
+    Address seedAddress {0};
+    std::array<Address, 2> addresses {{0, 0}};
+
+    unsigned seed {0};
+    std::string isg;
+
+    // the seed preceding the countdown filename is the same as the seed of both structures of the rules
+    bool seedCopiesMatch {false};
+
+    // the ISG filename names a known level and difficulty
+    bool isgValid {false};
+
+    // the structure is located in a kind of region which held the challenge during the previous scans
+    // it is only known when the memory is scanned
+    bool likelyRegion {false};
+
+    // the higher, the more likely the candidate is the running challenge
+    unsigned getScore() const noexcept;
+};
+
+// the result of 'Challenge::check'
+enum class ChallengeStatus
+{
+    Unchanged,
+    Changed,
+    Lost
+};
+
 class Challenge
 {
     public:
         Challenge();
         Challenge(const std::string programFilename);
         void openProcess(const std::string programFilename);
+
+        // uses a memory snapshot instead of the running game
+        void openSnapshot(const std::string &filename);
+
+        // uses the memory of 'backend' instead of the running game
+        void openProcess(std::shared_ptr<ProcessBackend> backend);
+        void saveSnapshot(const std::string &filename);
+
+        // throws if the scan is stopped through 'getScanControl'
         void load();
 
+        // cancels the scans of 'load' from another thread, and reports their progress
+        ScanControl& getScanControl() noexcept;
+
+        // what the last 'load' did, it is reset by the next one
+        ScanStats& getStats() noexcept;
+
+        // loads the addresses found during the previous sessions from 'filename'
+        // and saves the new ones into it
+        void setAddressCacheFile(const std::string &filename) noexcept;
+
+        // loads the statistics of the regions which held the challenge from 'filename'
+        // and saves the new ones into it
+        void setRegionStatsFile(const std::string &filename) noexcept;
+
+        // loads the pointer chains leading to the challenge, one per line:
+        // <module fingerprint> <seed|address0|address1> <pointer chain>
+        // the lines starting with '#' are ignored
+        void setPointerChainFile(const std::string &filename) noexcept;
+
+        // uses the address cache and the region statistics of 'other', so that the
+        // challenges of several game instances share them and save them into the same files
+        void shareCaches(const Challenge &other) noexcept;
+
+        // sets the number of threads which scan the process memory, 0 means one per hardware thread
+        void setScanThreadCount(unsigned count) noexcept;
+
+        // returns the ID of the opened process
+        unsigned getProcessId() const noexcept;
+
         // These following functions converts the challenge informations
         // into readable strings.
         std::string getLevelName() const noexcept;
@@ -53,25 +135,83 @@ class Challenge
 
         void updateRules(unsigned seed, float goal, float limit);
 
+        // the challenge structures found by the last 'load', the most likely first
+        // the addresses found without scanning are the only candidate
+        const std::vector<ChallengeCandidate>& getCandidates() const noexcept;
+
+        // returns the index of the candidate whose rules are read and written, the first one after 'load'
+        std::size_t getSelectedCandidate() const noexcept;
+
+        // reads and writes the rules of another candidate from now on
+        // throws if its seed copies don't match or if it doesn't hold a challenge anymore,
+        // the selected candidate is kept in that case
+        void selectCandidate(std::size_t index);
+
+        // reads the rules of the loaded challenge again, without scanning
+        // only a few bytes are read if they didn't change, so that it can be called often
+        // 'Lost' means the structures don't hold a challenge anymore, 'load' must be called again
+        ChallengeStatus check() noexcept;
+
     private:
         // We need 2 addresses to read/write the challenge rules. These
         // addresses are the locations of 2 occurrences of the challenge seed.
         // This function will try to find them in the process memory and store
         // them in 'm_addresses'.
+        // The addresses found in the same launch of the game are cached, they
+        // are only checked again instead of scanning the process memory.
         void findAddresses();
 
+        // returns true if the addresses still point to the challenge, in which
+        // case the seed is read into 'seed'
+        bool checkAddresses(Address seedAddress, const std::array<Address, 2> &addresses, unsigned &seed) noexcept;
+
+        // follows the pointer chains known for the running build of the game
+        // returns false if there are none or if they don't lead to the challenge
+        bool resolveAddresses(std::uint64_t moduleFingerprint) noexcept;
+
+        // scans the process memory for the addresses, the likely regions first
+        void scanAddresses();
+
+        // finds every challenge structure among the anchors of 'm_occurrences' and selects the most
+        // likely one, throws if none is found
+        // the candidates located in 'likelyRegions' are preferred, they must be sorted by address
+        void searchOccurrences(const std::vector<MemoryRegion> &likelyRegions);
+
+        // returns the structure of the rules located before the search limit whose ISG filename is 'isg'
+        // and whose seed is 'seed', the closest to the limit, or 'Process::npos'
+        Address findFirstAddress(const std::string &isg, unsigned seed);
+
+        // returns the candidate made of the current addresses, once their rules are read
+        ChallengeCandidate makeCandidate() const;
+
+        // saves the current addresses into the address cache, if the game launch can be identified
+        void storeAddresses();
+
         // Each of these 2 addresses points to a structure which contains
         // informations about the challenge (seed, goal, score limit, level
         // difficulty, event). Both structures are the same, so using one
         // address is enough to read the informations.
-        // This function will read the informations of the challenge and store
-        // them in 'm_goal', 'm_limit', 'm_level', 'm_event' and 'm_difficulty'
-        void readRules() noexcept;
+        // This function will read the informations of the challenge located at
+        // 'address' and store them in 'm_goal', 'm_limit', 'm_level', 'm_event'
+        // and 'm_difficulty'
+        // All of them are read at once, false is returned if it fails, in which
+        // case nothing is changed.
+        bool readRules(Address address) noexcept;
 
         Process m_process;
+        std::shared_ptr<AddressCache> m_addressCache {std::make_shared<AddressCache>()};
+        std::shared_ptr<RegionStats> m_regionStats {std::make_shared<RegionStats>()};
+        std::vector<ChallengeChains> m_pointerChains;
+
+        // the anchors found by the last scan
+        OccurrenceIndex m_occurrences;
         std::array<Address, 2> m_addresses;
         Address m_seedAddress;
 
+        std::vector<ChallengeCandidate> m_candidates;
+        std::size_t m_selectedCandidate {0};
+
+        std::string m_isg;
         unsigned m_seed {0};
         float m_goal {0};
         float m_limit {0};
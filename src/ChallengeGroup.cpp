@@ -0,0 +1,277 @@
+#include "ChallengeGroup.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+#include "ProcessRegistry.hpp"
+
+using std::cout;
+using std::endl;
+
+ChallengeGroup::ChallengeGroup()
+{
+}
+
+void ChallengeGroup::setAddressCacheFile(const std::string &filename) noexcept
+{
+    m_caches.setAddressCacheFile(filename);
+}
+
+void ChallengeGroup::setRegionStatsFile(const std::string &filename) noexcept
+{
+    m_caches.setRegionStatsFile(filename);
+}
+
+void ChallengeGroup::setPointerChainFile(const std::string &filename) noexcept
+{
+    m_pointerChainFilename = filename;
+
+    for(auto &instance : m_instances)
+        instance.challenge->setPointerChainFile(filename);
+}
+
+void ChallengeGroup::openProcesses(const std::string &programFilename)
+{
+    const auto processName = programFilename.substr(programFilename.find_last_of("/\\") + 1);
+
+    cout << endl << "Looking for the running instances of " << processName << "... " << endl;
+
+    const auto backends = ProcessRegistry::getInstance().openAll(programFilename);
+    if(backends.empty())
+    {
+        cout << "Failure!" << endl;
+        throw std::runtime_error("Failed to open process \"" + processName + "\"\nfrom \"" + programFilename + "\".");
+    }
+
+    cout << "Found " << std::dec << backends.size() << " instances." << endl;
+    openProcesses(backends);
+}
+
+void ChallengeGroup::openProcesses(const std::vector<std::shared_ptr<ProcessBackend>> &backends)
+{
+    std::vector<Instance> instances(backends.size());
+
+    {
+        // the instances still running keep their addresses and their scan cache, the others are dropped
+        std::lock_guard<std::mutex> lock(m_instancesMutex);
+
+        for(std::size_t i = 0; i < backends.size(); ++i)
+        {
+            auto instance = std::find_if(m_instances.begin(), m_instances.end(),
+                [&backends, i](const Instance &other){ return other.backend == backends[i]; });
+
+            if(instance != m_instances.end())
+                instances[i] = std::move(*instance);
+        }
+
+        m_instances.clear();
+    }
+
+    for(std::size_t i = 0; i < backends.size(); ++i)
+    {
+        if(instances[i].challenge)
+            continue;
+
+        instances[i] = makeInstance();
+        instances[i].backend = backends[i];
+        instances[i].challenge->openProcess(backends[i]);
+    }
+
+    setInstances(std::move(instances));
+}
+
+void ChallengeGroup::openSnapshot(const std::string &filename)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_instancesMutex);
+        m_instances.clear();
+    }
+
+    std::vector<Instance> instances;
+    instances.push_back(makeInstance());
+    instances.back().challenge->openSnapshot(filename);
+
+    setInstances(std::move(instances));
+}
+
+std::size_t ChallengeGroup::getInstanceCount() const noexcept
+{
+    return m_instances.size();
+}
+
+Challenge& ChallengeGroup::getInstance(std::size_t index) noexcept
+{
+    return *m_instances[index].challenge;
+}
+
+bool ChallengeGroup::isLoaded(std::size_t index) const noexcept
+{
+    return m_instances[index].loaded;
+}
+
+const std::string& ChallengeGroup::getError(std::size_t index) const noexcept
+{
+    return m_instances[index].error;
+}
+
+std::size_t ChallengeGroup::load()
+{
+    std::vector<std::size_t> indices(m_instances.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    // the instances are scanned at the same time, each one gets its share of the hardware threads
+    const auto threadCount = std::max(1u, std::thread::hardware_concurrency() / static_cast<unsigned>(std::max<std::size_t>(indices.size(), 1)));
+
+    forEach(indices, [threadCount](Instance &instance)
+    {
+        instance.loaded = false;
+        instance.challenge->setScanThreadCount(threadCount);
+        instance.challenge->load();
+        instance.loaded = true;
+    });
+
+    return static_cast<std::size_t>(std::count_if(m_instances.begin(), m_instances.end(),
+        [](const Instance &i){ return i.loaded; }));
+}
+
+bool ChallengeGroup::updateRules(std::size_t index, unsigned seed, float goal, float limit)
+{
+    std::vector<std::size_t> indices;
+    for(std::size_t i = 0; i < m_instances.size(); ++i)
+        if(index == i || (index == all && m_instances[i].loaded))
+            indices.push_back(i);
+
+    forEach(indices, [seed, goal, limit](Instance &instance)
+    {
+        if(!instance.loaded)
+            throw std::runtime_error("The challenge is not loaded.");
+
+        instance.challenge->updateRules(seed, goal, limit);
+    });
+
+    return std::all_of(indices.begin(), indices.end(), [this](std::size_t i){ return m_instances[i].error.empty(); });
+}
+
+void ChallengeGroup::startScans() noexcept
+{
+    std::lock_guard<std::mutex> lock(m_instancesMutex);
+    m_cancelled = false;
+
+    for(auto &instance : m_instances)
+        instance.challenge->getScanControl().start();
+}
+
+void ChallengeGroup::cancelScans() noexcept
+{
+    std::lock_guard<std::mutex> lock(m_instancesMutex);
+    m_cancelled = true;
+
+    for(auto &instance : m_instances)
+        instance.challenge->getScanControl().cancel();
+}
+
+bool ChallengeGroup::isCancelled() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_instancesMutex);
+    return m_cancelled;
+}
+
+void ChallengeGroup::setProgressCallback(ScanControl::ProgressCallback callback)
+{
+    std::lock_guard<std::mutex> lock(m_progressMutex);
+    m_progressCallback = std::move(callback);
+}
+
+ChallengeGroup::Instance ChallengeGroup::makeInstance()
+{
+    Instance instance;
+    instance.challenge.reset(new Challenge());
+    instance.challenge->shareCaches(m_caches);
+
+    if(!m_pointerChainFilename.empty())
+        instance.challenge->setPointerChainFile(m_pointerChainFilename);
+
+    return instance;
+}
+
+void ChallengeGroup::setInstances(std::vector<Instance> instances)
+{
+    std::lock_guard<std::mutex> lock(m_instancesMutex);
+    m_instances = std::move(instances);
+
+    // a cancellation requested while the processes were opened stops their scans too
+    if(m_cancelled)
+        for(auto &instance : m_instances)
+            instance.challenge->getScanControl().cancel();
+
+    connectProgress();
+}
+
+void ChallengeGroup::forEach(const std::vector<std::size_t> &indices, const std::function<void(Instance&)> &function)
+{
+    auto run = [this, &function](std::size_t index) noexcept
+    {
+        auto &instance = m_instances[index];
+
+        try
+        {
+            function(instance);
+            instance.error.clear();
+        }
+        catch(const std::exception &e)
+        {
+            instance.error = e.what();
+        }
+    };
+
+    // the last instance is handled by the calling thread
+    std::vector<std::thread> threads;
+    try
+    {
+        for(std::size_t i = 0; i + 1 < indices.size(); ++i)
+            threads.emplace_back(run, indices[i]);
+    }
+    catch(...)
+    {
+        // the started threads must be joined before they are destroyed
+        for(auto &thread : threads)
+            thread.join();
+
+        throw;
+    }
+
+    if(!indices.empty())
+        run(indices.back());
+
+    for(auto &thread : threads)
+        thread.join();
+}
+
+void ChallengeGroup::connectProgress()
+{
+    for(std::size_t i = 0; i < m_instances.size(); ++i)
+    {
+        m_instances[i].progress = ScanProgress();
+
+        m_instances[i].challenge->getScanControl().setProgressCallback([this, i](const ScanProgress &progress)
+        {
+            std::lock_guard<std::mutex> lock(m_progressMutex);
+            m_instances[i].progress = progress;
+
+            if(!m_progressCallback)
+                return;
+
+            ScanProgress total;
+            for(const auto &instance : m_instances)
+            {
+                total.scannedSize += instance.progress.scannedSize;
+                total.totalSize += instance.progress.totalSize;
+                total.remainingBlocks += instance.progress.remainingBlocks;
+                total.candidateCount += instance.progress.candidateCount;
+            }
+
+            m_progressCallback(total);
+        });
+    }
+}
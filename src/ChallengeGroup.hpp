@@ -0,0 +1,108 @@
+#ifndef CHALLENGEGROUP_H
+#define CHALLENGEGROUP_H
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Challenge.hpp"
+
+// The challenges of every running instance of the game. Each instance keeps its
+// own process, addresses and rules, they are loaded and updated in parallel.
+// The address cache and the region statistics are shared by the instances.
+class ChallengeGroup
+{
+    public:
+        ChallengeGroup();
+
+        ChallengeGroup(const ChallengeGroup&) = delete;
+        ChallengeGroup& operator=(const ChallengeGroup&) = delete;
+
+        // see 'Challenge', the files are used by every instance
+        void setAddressCacheFile(const std::string &filename) noexcept;
+        void setRegionStatsFile(const std::string &filename) noexcept;
+        void setPointerChainFile(const std::string &filename) noexcept;
+
+        // attaches to every running process whose main module is 'programFilename', sorted by process ID
+        // the instances which are still running keep their state, the others are dropped
+        // throws if no such process is running
+        void openProcesses(const std::string &programFilename);
+
+        // same as above, with one instance per backend, in the same order
+        void openProcesses(const std::vector<std::shared_ptr<ProcessBackend>> &backends);
+
+        // replaces the instances with a memory snapshot
+        void openSnapshot(const std::string &filename);
+
+        std::size_t getInstanceCount() const noexcept;
+        Challenge& getInstance(std::size_t index) noexcept;
+
+        // returns true if the last 'load' of the instance succeeded
+        bool isLoaded(std::size_t index) const noexcept;
+
+        // returns why the last 'load' or 'updateRules' of the instance failed, or an empty string
+        const std::string& getError(std::size_t index) const noexcept;
+
+        // loads every instance in parallel, the scanning threads being shared out between them
+        // returns the number of instances which were loaded, see 'getError' for the others
+        std::size_t load();
+
+        // writes the rules into the instance 'index', or into every loaded instance in parallel
+        // if 'index' is 'all', returns false if one of them failed, see 'getError'
+        bool updateRules(std::size_t index, unsigned seed, float goal, float limit);
+
+        // clears the cancellation of every instance, see 'ScanControl::start'
+        void startScans() noexcept;
+
+        // stops the scans of every instance, it can be called from any thread
+        // the instances opened afterwards are cancelled too, until 'startScans' is called
+        void cancelScans() noexcept;
+        bool isCancelled() const noexcept;
+
+        // 'callback' receives the progress summed over the instances, see 'ScanControl::setProgressCallback'
+        void setProgressCallback(ScanControl::ProgressCallback callback);
+
+        // an index meaning every instance
+        static const std::size_t all {std::numeric_limits<std::size_t>::max()};
+
+    private:
+        struct Instance
+        {
+            // null if the instance is a snapshot
+            std::shared_ptr<ProcessBackend> backend;
+
+            std::unique_ptr<Challenge> challenge;
+            bool loaded {false};
+            std::string error;
+            ScanProgress progress;
+        };
+
+        // creates an instance using the files and the caches of the group
+        Instance makeInstance();
+
+        // replaces the instances, so that 'cancelScans' can be called while they are opened
+        void setInstances(std::vector<Instance> instances);
+
+        // calls 'function' for the instances of 'indices' in parallel and stores its errors
+        void forEach(const std::vector<std::size_t> &indices, const std::function<void(Instance&)> &function);
+
+        // sets the progress callback of every instance
+        void connectProgress();
+
+        // holds the caches shared by the instances, it is never opened
+        Challenge m_caches;
+        std::string m_pointerChainFilename;
+        std::vector<Instance> m_instances;
+
+        // guards the replacement of 'm_instances' against 'cancelScans'
+        mutable std::mutex m_instancesMutex;
+        bool m_cancelled {false};
+
+        std::mutex m_progressMutex;
+        ScanControl::ProgressCallback m_progressCallback;
+};
+
+#endif // CHALLENGEGROUP_H
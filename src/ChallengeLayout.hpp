@@ -0,0 +1,114 @@
+#ifndef CHALLENGELAYOUT_H
+#define CHALLENGELAYOUT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ByteOrder.hpp"
+
+// The challenge structures of the game memory. Each field knows its offset
+// and its endianness, so that a structure is read as a single block and its
+// fields are decoded from it.
+
+// a value located 'Offset' bytes after the start of its structure
+template<typename T, std::size_t Offset, Endianness E> struct Field
+{
+    using Type = T;
+
+    static constexpr std::size_t offset {Offset};
+    static constexpr std::size_t size {sizeof(T)};
+    static constexpr Endianness endianness {E};
+
+    // 'structure' holds the structure from its start
+    static T decode(const char *structure) noexcept
+    {
+        return decodeValue<T>(structure + Offset, E);
+    }
+
+    static void encode(T value, char *structure) noexcept
+    {
+        encodeValue(value, E, structure + Offset);
+    }
+};
+
+// a null terminated string of at most 'Size' bytes
+template<std::size_t Offset, std::size_t Size> struct StringField
+{
+    static constexpr std::size_t offset {Offset};
+    static constexpr std::size_t size {Size};
+
+    static std::string decode(const char *structure)
+    {
+        const auto first = structure + Offset;
+        return std::string(first, std::find(first, first + Size, '\0'));
+    }
+};
+
+// the structure holding the rules, the game keeps 2 copies of it ('Challenge::m_addresses')
+struct RulesLayout
+{
+    using Seed = Field<std::uint32_t, 0x00, Endianness::Big>;
+    using Goal = Field<float, 0x0C, Endianness::Little>;
+    using Limit = Field<float, 0x10, Endianness::Little>;
+
+    // the name of the ISG file of the challenge, "challenge_run_timeattack_expert.isg" for instance
+    using Isg = StringField<0x34, 260>;
+
+    // the structure is read from its seed to the end of its ISG filename
+    static constexpr std::size_t size {Isg::offset + Isg::size};
+};
+
+// the third copy of the seed is followed by the countdown filename, which depends on the level
+enum class CountdownKind { Regular, Dojo };
+
+template<CountdownKind Kind> struct CountdownLayout;
+
+// the offsets are relative to the seed ('Challenge::m_seedAddress')
+struct CountdownSeed
+{
+    using Seed = Field<std::uint32_t, 0x00, Endianness::Big>;
+};
+
+// "countdown.act", in every level but the Dojo
+template<> struct CountdownLayout<CountdownKind::Regular> : CountdownSeed
+{
+    static constexpr std::size_t nameOffset {0x0C};
+
+    // the second structure of the rules is located this many bytes before the seed
+    static constexpr std::size_t rulesOffset {0x5F8};
+};
+
+// "countdown_shaolin.act"
+template<> struct CountdownLayout<CountdownKind::Dojo> : CountdownSeed
+{
+    static constexpr std::size_t nameOffset {0x74};
+    static constexpr std::size_t rulesOffset {0x12C};
+};
+
+// the offsets of a countdown layout, for the code which only knows the level once the memory is read
+struct CountdownOffsets
+{
+    std::size_t nameOffset;
+    std::size_t rulesOffset;
+};
+
+template<CountdownKind Kind> constexpr CountdownOffsets getCountdownOffsets() noexcept
+{
+    return {CountdownLayout<Kind>::nameOffset, CountdownLayout<Kind>::rulesOffset};
+}
+
+constexpr CountdownOffsets getCountdownOffsets(CountdownKind kind) noexcept
+{
+    return kind == CountdownKind::Dojo ? getCountdownOffsets<CountdownKind::Dojo>()
+        : getCountdownOffsets<CountdownKind::Regular>();
+}
+
+static_assert(RulesLayout::Limit::offset + RulesLayout::Limit::size <= RulesLayout::Isg::offset,
+    "the values of the rules are located before the ISG filename");
+static_assert(CountdownLayout<CountdownKind::Regular>::nameOffset >= CountdownSeed::Seed::size
+    && CountdownLayout<CountdownKind::Dojo>::nameOffset >= CountdownSeed::Seed::size,
+    "the countdown filename follows the seed");
+
+#endif // CHALLENGELAYOUT_H
@@ -0,0 +1,61 @@
+#include "ChallengeWatcher.hpp"
+
+#include <algorithm>
+
+const int ChallengeWatcher::minInterval;
+const int ChallengeWatcher::maxInterval;
+
+ChallengeWatcher::ChallengeWatcher(ChallengeGroup &challenges, QObject *parent) :
+    QObject(parent), m_challenges(challenges)
+{
+    // the timer is restarted after each poll with the new interval
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::CoarseTimer);
+
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(poll()));
+}
+
+void ChallengeWatcher::start()
+{
+    m_interval = minInterval;
+    m_timer.start(m_interval);
+}
+
+void ChallengeWatcher::stop()
+{
+    m_timer.stop();
+}
+
+bool ChallengeWatcher::isActive() const noexcept
+{
+    return m_timer.isActive();
+}
+
+void ChallengeWatcher::poll()
+{
+    bool changed {false};
+
+    for(std::size_t i = 0; i < m_challenges.getInstanceCount(); ++i)
+    {
+        if(!m_challenges.isLoaded(i))
+            continue;
+
+        switch(m_challenges.getInstance(i).check())
+        {
+            case ChallengeStatus::Unchanged:
+                break;
+
+            case ChallengeStatus::Changed:
+                changed = true;
+                emit challengeChanged(static_cast<int>(i));
+                break;
+
+            case ChallengeStatus::Lost:
+                emit challengeLost(static_cast<int>(i));
+                return;
+        }
+    }
+
+    m_interval = changed ? minInterval : std::min(m_interval * 3 / 2, maxInterval);
+    m_timer.start(m_interval);
+}
@@ -0,0 +1,46 @@
+#ifndef CHALLENGEWATCHER_H
+#define CHALLENGEWATCHER_H
+
+#include <QObject>
+#include <QTimer>
+
+#include "ChallengeGroup.hpp"
+
+// Polls the structures of the loaded challenges, so that a new challenge rolled
+// by the game is displayed without scanning the process memory again.
+// Each poll is a single batch read of a few bytes per game instance. The interval
+// grows while the challenges don't change and goes back to the minimum when one does.
+class ChallengeWatcher : public QObject
+{
+    Q_OBJECT
+
+    public:
+        ChallengeWatcher(ChallengeGroup &challenges, QObject *parent = nullptr);
+
+        // the instances which are not loaded are skipped
+        // the challenges must not be used by another thread while they are watched
+        void start();
+        void stop();
+
+        bool isActive() const noexcept;
+
+        static const int minInterval {250};
+        static const int maxInterval {2000};
+
+    signals:
+        // the rules of the instance 'index' have been read again
+        void challengeChanged(int index);
+
+        // the structures of the instance 'index' don't hold a challenge anymore, the watcher is stopped
+        void challengeLost(int index);
+
+    private slots:
+        void poll();
+
+    private:
+        ChallengeGroup &m_challenges;
+        QTimer m_timer;
+        int m_interval {minInterval};
+};
+
+#endif // CHALLENGEWATCHER_H
@@ -1,5 +1,8 @@
 #include "Clock.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 Clock::Clock() :
     m_timePoint(hrClock::now())
 {
@@ -20,3 +23,12 @@ float Clock::elapsed() const noexcept
 
     return static_cast<float>(elapsedTime.count()) / 1000;
 }
+
+double getPercentile(const std::vector<double> &sortedTimes, double percent)
+{
+    if(sortedTimes.empty())
+        return 0;
+
+    const auto rank = static_cast<std::size_t>(std::ceil(percent / 100 * sortedTimes.size()));
+    return sortedTimes[std::min(std::max<std::size_t>(rank, 1), sortedTimes.size()) - 1];
+}
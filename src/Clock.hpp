@@ -3,6 +3,7 @@
 
 #include <chrono>
 #include <memory>
+#include <vector>
 
 using hrClock = std::chrono::high_resolution_clock;
 
@@ -17,4 +18,8 @@ class Clock
         hrClock::time_point m_timePoint;
 };
 
+// the nearest rank percentile of 'sortedTimes', 'percent' between 0 and 100
+// returns 0 if there is no time
+double getPercentile(const std::vector<double> &sortedTimes, double percent);
+
 #endif // CLOCK_H
@@ -0,0 +1,67 @@
+#include "GameFolder.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "Process.hpp"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::flush;
+
+std::string getGameFolder(const std::string &exePath)
+{
+    std::string gameFolder;
+
+    auto saveFilename = exePath.substr(0, exePath.find_last_of("/\\") + 1) + "gamedir.sav";
+    std::ifstream ifs(saveFilename);
+    if(ifs)
+    {
+        std::ostringstream str;
+        str << ifs.rdbuf();
+        gameFolder = str.str();
+
+        ifs.close();
+    }
+
+    if(!gameFolder.empty())
+        cout << "Game directory:" << endl << gameFolder << endl;
+
+    else
+    {
+        gameFolder = locateGameFolder();
+
+        std::ofstream ofs(saveFilename, std::ios::out | std::ios::trunc);
+        if(ofs)
+        {
+            ofs << gameFolder;
+            ofs.close();
+        }
+
+        else
+            cerr << "Warning: Failed to save game directory into file \"" << saveFilename << "\"!" << endl;
+    }
+
+    return gameFolder;
+}
+
+std::string locateGameFolder()
+{
+    cout << "Locating game directory... " << flush;
+
+    auto gameFolder = Process::getProcessLocation(gameName);
+
+    if(gameFolder.empty())
+    {
+        cout << "Failure!" << endl;
+        throw std::runtime_error("Can't locate the game directory because \"" + gameName + "\" is not running!\n"
+            + "Please launch the game.");
+    }
+
+    cout << "Success!" << endl << "Found: " << gameFolder << endl;
+
+    return gameFolder;
+}
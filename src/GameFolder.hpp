@@ -0,0 +1,18 @@
+#ifndef GAMEFOLDER_H
+#define GAMEFOLDER_H
+
+#include <string>
+
+// the executable of the game and its data package, located in the game folder
+const std::string gameName {"Rayman Legends.exe"};
+const std::string bundleName {"Bundle_PC.ipk"};
+
+// returns the game folder saved into "gamedir.sav", next to 'exePath'
+// if there is none, it is located through the running game and saved
+// throws std::runtime_error if it can't be located
+std::string getGameFolder(const std::string &exePath);
+
+// returns the folder of the running game, throws std::runtime_error if it is not running
+std::string locateGameFolder();
+
+#endif // GAMEFOLDER_H
@@ -0,0 +1,42 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+// fast non-cryptographic hash of a memory block, 8 bytes at a time
+// it is used to fingerprint pages and modules of the process memory
+// the blocks of 32 bytes are hashed on 4 independent lanes, so that the
+// multiplications don't wait for each other
+inline std::uint64_t hashBytes(const char *data, std::size_t length, std::uint64_t seed = 0) noexcept
+{
+    const std::uint64_t prime {0x9E37'79B9'7F4A'7C15};
+
+    auto mix = [prime](std::uint64_t hash, const char *bytes) noexcept
+    {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        hash = (hash ^ word) * prime;
+        return hash ^ (hash >> 29);
+    };
+
+    std::uint64_t lanes[4] {seed ^ (length * prime), seed + 1, seed + 2, seed + 3};
+
+    std::size_t i {0};
+    for(; i + 32 <= length; i += 32)
+        for(unsigned lane = 0; lane < 4; ++lane)
+            lanes[lane] = mix(lanes[lane], data + i + lane * 8);
+
+    auto hash = lanes[0] ^ (lanes[1] * 3) ^ (lanes[2] * 5) ^ (lanes[3] * 7);
+
+    for(; i + 8 <= length; i += 8)
+        hash = mix(hash, data + i);
+
+    for(; i < length; ++i)
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * prime;
+
+    return hash ^ (hash >> 32);
+}
+
+#endif // HASH_H
@@ -0,0 +1,37 @@
+#include "Json.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+std::string toJsonString(const std::string &str)
+{
+    std::string json {'"'};
+    for(auto c : str)
+    {
+        if(static_cast<unsigned char>(c) < 0x20)
+        {
+            char escaped[7];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            json += escaped;
+            continue;
+        }
+
+        if(c == '"' || c == '\\')
+            json += '\\';
+
+        json += c;
+    }
+
+    return json + '"';
+}
+
+std::string toJsonNumber(double value)
+{
+    if(!std::isfinite(value))
+        return "null";
+
+    std::ostringstream os;
+    os << value;
+    return os.str();
+}
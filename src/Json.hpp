@@ -0,0 +1,12 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <string>
+
+// 'str' as a quoted JSON string, the quotes, the backslashes and the control characters being escaped
+std::string toJsonString(const std::string &str);
+
+// 'value' as a JSON number, or null if it is not finite (JSON has no NaN nor infinity)
+std::string toJsonNumber(double value);
+
+#endif // JSON_H
@@ -0,0 +1,471 @@
+#include "ProcessBackend.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+// The game runs under Wine (or Proton), the Windows process being a regular Linux
+// process whose command line starts with the Windows path of the executable.
+
+namespace
+{
+    std::string strToUpper(const std::string &str)
+    {
+        std::string newStr;
+        std::transform(str.begin(), str.end(), std::back_inserter(newStr), ::toupper);
+        return newStr;
+    }
+
+    std::string getFilename(const std::string &path)
+    {
+        return path.substr(path.find_last_of("/\\") + 1);
+    }
+
+    // parses the whole of 'str' as a number written in 'base' into 'value'
+    // returns false if it is not such a number, the files of /proc may be cut when the process exits
+    bool parseNumber(const std::string &str, int base, std::uint64_t &value) noexcept
+    {
+        if(str.empty() || !std::isxdigit(static_cast<unsigned char>(str[0])))
+            return false;
+
+        char *end {nullptr};
+        errno = 0;
+        const auto number = std::strtoull(str.c_str(), &end, base);
+        if(errno == ERANGE || end != str.c_str() + str.size())
+            return false;
+
+        value = number;
+        return true;
+    }
+
+    // parses the "start-end" range of a line of /proc/<pid>/maps
+    bool parseRange(const std::string &range, Address &first, Address &last) noexcept
+    {
+        const auto separator = range.find('-');
+        if(separator == std::string::npos)
+            return false;
+
+        std::uint64_t start, end;
+        if(!parseNumber(range.substr(0, separator), 16, start) || !parseNumber(range.substr(separator + 1), 16, end) || end < start)
+            return false;
+
+        first = static_cast<Address>(start);
+        last = static_cast<Address>(end);
+        return true;
+    }
+
+    // reads a file of /proc made of null separated strings
+    std::vector<std::string> readStrings(const std::string &filename)
+    {
+        std::ifstream ifs(filename, std::ios::binary);
+        std::vector<std::string> strings;
+
+        std::string str;
+        while(std::getline(ifs, str, '\0'))
+            strings.push_back(str);
+
+        return strings;
+    }
+
+    std::string getEnvironmentVariable(unsigned processId, const std::string &name)
+    {
+        for(const auto &variable : readStrings("/proc/" + std::to_string(processId) + "/environ"))
+            if(variable.compare(0, name.size() + 1, name + "=") == 0)
+                return variable.substr(name.size() + 1);
+
+        return "";
+    }
+
+    // converts a Wine path (such as "C:\Games\Rayman Legends\Rayman Legends.exe")
+    // into a path of the host, using the drives of the Wine prefix of the process
+    std::string toHostPath(unsigned processId, std::string path)
+    {
+        if(path.compare(0, 4, "\\??\\") == 0)
+            path.erase(0, 4);
+
+        char resolved[PATH_MAX];
+
+        // host path, relative to the working directory of the process if needed
+        if(path.size() < 2 || path[1] != ':')
+        {
+            if(path.empty() || path[0] == '/')
+                return path;
+
+            const auto absolutePath = "/proc/" + std::to_string(processId) + "/cwd/" + path;
+            return realpath(absolutePath.c_str(), resolved) != nullptr ? resolved : "";
+        }
+
+        auto prefix = getEnvironmentVariable(processId, "WINEPREFIX");
+        if(prefix.empty())
+            prefix = getEnvironmentVariable(processId, "HOME") + "/.wine";
+
+        const auto drive = prefix + "/dosdevices/" + static_cast<char>(std::tolower(path[0])) + ":";
+
+        if(realpath(drive.c_str(), resolved) == nullptr)
+            return "";
+
+        auto hostPath = path.substr(2);
+        std::replace(hostPath.begin(), hostPath.end(), '\\', '/');
+
+        return std::string(resolved) + (std::string(resolved) == "/" ? hostPath.substr(1) : hostPath);
+    }
+
+    // returns the executable path of the process, as seen by the host
+    std::string getModuleFilename(unsigned processId)
+    {
+        const auto arguments = readStrings("/proc/" + std::to_string(processId) + "/cmdline");
+        if(arguments.empty())
+            return "";
+
+        return toHostPath(processId, arguments[0]);
+    }
+
+    // returns the start time of the process in clock ticks since the boot, or 0 if it is not running
+    std::uint64_t readStartTime(unsigned processId)
+    {
+        std::ifstream ifs("/proc/" + std::to_string(processId) + "/stat");
+        std::string stat;
+        std::getline(ifs, stat);
+
+        // the start time is the 22nd field, the 2nd one (the name) can hold spaces
+        const auto nameEnd = stat.rfind(')');
+        if(nameEnd == std::string::npos)
+            return 0;
+
+        // the 3rd field is the state, the zombies have exited already
+        std::istringstream stream(stat.substr(nameEnd + 1));
+        std::string field;
+        for(unsigned i = 3; i <= 22; ++i)
+        {
+            stream >> field;
+            if(i == 3 && (field == "Z" || field == "X"))
+                return 0;
+        }
+
+        std::uint64_t startTime {0};
+        return stream && parseNumber(field, 10, startTime) ? startTime : 0;
+    }
+
+    // returns the identifiers of the processes whose executable is named 'processName'
+    std::vector<unsigned> findProcessIds(const std::string &processName)
+    {
+        std::vector<unsigned> processIds;
+
+        auto dir = opendir("/proc");
+        if(dir == nullptr)
+            return processIds;
+
+        while(auto entry = readdir(dir))
+        {
+            const std::string name = entry->d_name;
+            if(name.empty() || !std::all_of(name.begin(), name.end(), ::isdigit))
+                continue;
+
+            const auto processId = static_cast<unsigned>(std::stoul(name));
+            const auto arguments = readStrings("/proc/" + name + "/cmdline");
+            if(!arguments.empty() && getFilename(arguments[0]) == processName)
+                processIds.push_back(processId);
+        }
+
+        closedir(dir);
+        std::sort(processIds.begin(), processIds.end());
+
+        return processIds;
+    }
+
+    class LinuxProcessBackend : public ProcessBackend
+    {
+        public:
+            LinuxProcessBackend(unsigned processId, std::uint64_t startTime) :
+                m_processId(processId), m_startTime(startTime)
+            {
+                // used when process_vm_readv/process_vm_writev are not available
+                m_memoryFile = ::open(("/proc/" + std::to_string(processId) + "/mem").c_str(), O_RDWR);
+            }
+
+            ~LinuxProcessBackend() override
+            {
+                if(m_memoryFile != -1)
+                    close(m_memoryFile);
+            }
+
+            bool read(Address address, char *buffer, std::size_t length) noexcept override
+            {
+                iovec local {buffer, length};
+                iovec remote {reinterpret_cast<void*>(address), length};
+
+                const auto result = process_vm_readv(static_cast<pid_t>(m_processId), &local, 1, &remote, 1, 0);
+                if(result >= 0)
+                    return static_cast<std::size_t>(result) == length;
+
+                if(errno != ENOSYS && errno != EPERM)
+                    return false;
+
+                return m_memoryFile != -1
+                    && pread(m_memoryFile, buffer, length, static_cast<off_t>(address)) == static_cast<ssize_t>(length);
+            }
+
+            std::size_t readBatch(ReadRequest *requests, std::size_t count) noexcept override
+            {
+                // process_vm_readv stops at the first area which can't be read, this one is read
+                // again on its own (it may be readable through /proc/<pid>/mem) and the batch goes on
+                std::array<iovec, maxBatchSize> local, remote;
+                std::size_t successCount {0};
+
+                for(std::size_t first = 0; first < count;)
+                {
+                    const auto size = std::min(count - first, maxBatchSize);
+                    for(std::size_t i = 0; i < size; ++i)
+                    {
+                        const auto &request = requests[first + i];
+                        local[i] = {request.buffer, request.length};
+                        remote[i] = {reinterpret_cast<void*>(request.address), request.length};
+                    }
+
+                    const auto result = process_vm_readv(static_cast<pid_t>(m_processId),
+                        local.data(), size, remote.data(), size, 0);
+
+                    auto transferred = result > 0 ? static_cast<std::size_t>(result) : 0;
+
+                    std::size_t i {0};
+                    for(; i < size && requests[first + i].length <= transferred; ++i)
+                    {
+                        transferred -= requests[first + i].length;
+                        requests[first + i].success = true;
+                        ++successCount;
+                    }
+
+                    if(i < size)
+                    {
+                        auto &request = requests[first + i];
+                        request.success = read(request.address, request.buffer, request.length);
+                        successCount += request.success;
+                        ++i;
+                    }
+
+                    first += i;
+                }
+
+                return successCount;
+            }
+
+            bool write(Address address, const char *buffer, std::size_t length) noexcept override
+            {
+                iovec local {const_cast<char*>(buffer), length};
+                iovec remote {reinterpret_cast<void*>(address), length};
+
+                const auto result = process_vm_writev(static_cast<pid_t>(m_processId), &local, 1, &remote, 1, 0);
+                if(result >= 0 && static_cast<std::size_t>(result) == length)
+                    return true;
+
+                // unlike process_vm_writev, /proc/<pid>/mem can write into read-only pages
+                return m_memoryFile != -1
+                    && pwrite(m_memoryFile, buffer, length, static_cast<off_t>(address)) == static_cast<ssize_t>(length);
+            }
+
+            std::size_t writeBatch(WriteRequest *requests, std::size_t count) noexcept override
+            {
+                // same as 'readBatch', the areas which can't be written through process_vm_writev
+                // (such as read-only pages) are written on their own through /proc/<pid>/mem
+                std::array<iovec, maxBatchSize> local, remote;
+                std::size_t successCount {0};
+
+                for(std::size_t first = 0; first < count;)
+                {
+                    const auto size = std::min(count - first, maxBatchSize);
+                    for(std::size_t i = 0; i < size; ++i)
+                    {
+                        const auto &request = requests[first + i];
+                        local[i] = {const_cast<char*>(request.buffer), request.length};
+                        remote[i] = {reinterpret_cast<void*>(request.address), request.length};
+                    }
+
+                    const auto result = process_vm_writev(static_cast<pid_t>(m_processId),
+                        local.data(), size, remote.data(), size, 0);
+
+                    auto transferred = result > 0 ? static_cast<std::size_t>(result) : 0;
+
+                    std::size_t i {0};
+                    for(; i < size && requests[first + i].length <= transferred; ++i)
+                    {
+                        transferred -= requests[first + i].length;
+                        requests[first + i].success = true;
+                        ++successCount;
+                    }
+
+                    if(i < size)
+                    {
+                        auto &request = requests[first + i];
+                        request.success = write(request.address, request.buffer, request.length);
+                        successCount += request.success;
+                        ++i;
+                    }
+
+                    first += i;
+                }
+
+                return successCount;
+            }
+
+            std::vector<MemoryRegion> getRegions() noexcept override
+            {
+                std::vector<MemoryRegion> regions;
+                std::ifstream maps("/proc/" + std::to_string(m_processId) + "/maps");
+
+                std::string line;
+                while(std::getline(maps, line))
+                {
+                    // start-end perms offset dev inode pathname
+                    std::istringstream stream(line);
+                    std::string range, permissions, offset, device, inode, pathname;
+                    stream >> range >> permissions >> offset >> device >> inode;
+                    std::getline(stream >> std::ws, pathname);
+
+                    // the kernel pages can't be read through process_vm_readv
+                    if(permissions.size() < 3 || permissions[0] != 'r'
+                        || pathname == "[vvar]" || pathname == "[vsyscall]" || pathname == "[vvar_vclock]")
+                        continue;
+
+                    Address first, last;
+                    if(!parseRange(range, first, last))
+                        continue;
+
+                    MemoryRegion region;
+                    region.base = first;
+                    region.size = last - first;
+                    region.writable = permissions[1] == 'w';
+                    region.executable = permissions[2] == 'x';
+
+                    // Windows modules are mapped from their files by Wine
+                    const auto extension = strToUpper(pathname.substr(pathname.find_last_of('.') + 1));
+                    if(pathname.empty() || pathname[0] == '[')
+                        region.type = RegionType::Private;
+                    else if(extension == "EXE" || extension == "DLL" || extension == "SO")
+                        region.type = RegionType::Image;
+                    else
+                        region.type = RegionType::Mapped;
+
+                    regions.push_back(region);
+                }
+
+                return regions;
+            }
+
+            unsigned getProcessId() const noexcept override
+            {
+                return m_processId;
+            }
+
+            std::string getModuleName() noexcept override
+            {
+                const auto arguments = readStrings("/proc/" + std::to_string(m_processId) + "/cmdline");
+                return arguments.empty() ? "" : getFilename(arguments[0]);
+            }
+
+            std::vector<Module> getModules() noexcept override
+            {
+                std::vector<Module> modules;
+                std::ifstream maps("/proc/" + std::to_string(m_processId) + "/maps");
+
+                // a module is made of the mappings of its file, the first one being its header
+                std::string line;
+                while(std::getline(maps, line))
+                {
+                    std::istringstream stream(line);
+                    std::string range, permissions, offset, device, inode, pathname;
+                    stream >> range >> permissions >> offset >> device >> inode;
+                    std::getline(stream >> std::ws, pathname);
+
+                    const auto extension = strToUpper(pathname.substr(pathname.find_last_of('.') + 1));
+                    Address first, last;
+                    if(pathname.empty() || pathname[0] == '[' || !parseRange(range, first, last)
+                        || (extension != "EXE" && extension != "DLL" && extension != "SO"))
+                        continue;
+
+                    const auto name = getFilename(pathname);
+
+                    auto module = std::find_if(modules.begin(), modules.end(),
+                        [&name](const Module &m){ return m.name == name; });
+
+                    if(module == modules.end())
+                    {
+                        Module newModule;
+                        newModule.name = name;
+                        newModule.base = first;
+                        modules.push_back(newModule);
+                        module = modules.end() - 1;
+                    }
+
+                    module->size = std::max<std::size_t>(module->size, last - module->base);
+                }
+
+                // the main module goes first
+                const auto moduleName = strToUpper(getModuleName());
+                auto mainModule = std::find_if(modules.begin(), modules.end(),
+                    [&moduleName](const Module &m){ return strToUpper(m.name) == moduleName; });
+
+                if(mainModule != modules.end())
+                    std::rotate(modules.begin(), mainModule, mainModule + 1);
+
+                return modules;
+            }
+
+            std::uint64_t getStartTime() noexcept override
+            {
+                return m_startTime;
+            }
+
+            // the ID may have been reused by another process, which started later
+            bool isAlive() noexcept override
+            {
+                return readStartTime(m_processId) == m_startTime;
+            }
+
+        private:
+            // number of areas given to process_vm_readv/process_vm_writev at once, below IOV_MAX
+            static const std::size_t maxBatchSize {64};
+
+            unsigned m_processId;
+            std::uint64_t m_startTime;
+            int m_memoryFile {-1};
+    };
+
+    const std::size_t LinuxProcessBackend::maxBatchSize;
+}
+
+std::vector<ProcessInfo> findProcesses(const std::string &processName)
+{
+    std::vector<ProcessInfo> processes;
+
+    for(auto processId : findProcessIds(processName))
+    {
+        ProcessInfo process;
+        process.processId = processId;
+        process.filename = getModuleFilename(processId);
+        process.startTime = readStartTime(processId);
+
+        if(!process.filename.empty() && process.startTime != 0)
+            processes.push_back(process);
+    }
+
+    return processes;
+}
+
+std::unique_ptr<ProcessBackend> openProcessBackend(const ProcessInfo &process)
+{
+    if(readStartTime(process.processId) != process.startTime)
+        return nullptr;
+
+    return std::unique_ptr<ProcessBackend>(new LinuxProcessBackend(process.processId, process.startTime));
+}
@@ -19,6 +19,9 @@ class UppercaseValidator : public QValidator
         }
 };
 
+const int MainFrame::minReloadInterval;
+const int MainFrame::maxReloadInterval;
+
 MainFrame::MainFrame(const std::string &exePath)
 {
     setWindowTitle("RL Challenge Manager");
@@ -35,6 +38,10 @@ MainFrame::MainFrame(const std::string &exePath)
 
     fileMenu->addSeparator();
 
+    auto openSnapshotAction = fileMenu->addAction("Open memory s&napshot...");
+
+    fileMenu->addSeparator();
+
     auto quitAction = fileMenu->addAction("&Quit");
     quitAction->setShortcut(QKeySequence("Ctrl+Q"));
 
@@ -48,19 +55,62 @@ MainFrame::MainFrame(const std::string &exePath)
 
     m_loadChallengeAction = challengeMenu->addAction("&Load current challenge");
     m_loadChallengeAction->setShortcut(QKeySequence("Ctrl+L"));
+    m_cancelLoadingAction = challengeMenu->addAction("&Cancel loading");
+    m_cancelLoadingAction->setShortcut(QKeySequence("Esc"));
+    m_cancelLoadingAction->setEnabled(false);
     auto applyChangeAction = challengeMenu->addAction("&Apply changes");
     applyChangeAction->setShortcut(QKeySequence("Ctrl+A"));
     auto resetChangeAction = challengeMenu->addAction("&Reset changes");
     resetChangeAction->setShortcut(QKeySequence("Ctrl+R"));
 
+    challengeMenu->addSeparator();
+
+    m_saveSnapshotAction = challengeMenu->addAction("Save memory &snapshot...");
+    m_saveSnapshotAction->setToolTip("Saves the game memory, so that the challenge can be loaded from it later");
+    m_exportStatsAction = challengeMenu->addAction("&Export load statistics...");
+    m_exportStatsAction->setToolTip("Saves what the last load did as JSON, to compare machines and game builds");
+
 
     /// CHALLENGE GROUP
 
+    m_instanceBox = new QComboBox(this);
+    m_instanceBox->setToolTip("The running instance of the game whose rules are displayed");
+    m_instanceBox->setMinimumWidth(190);
+
+    m_applyToAllCheck = new QCheckBox("Apply to all", this);
+    m_applyToAllCheck->setToolTip("Writes the changes into every loaded instance of the game");
+
+    auto instanceLayout = new QHBoxLayout();
+    instanceLayout->addWidget(new QLabel("Instance:"));
+    instanceLayout->addWidget(m_instanceBox);
+    instanceLayout->addWidget(m_applyToAllCheck);
+
+    m_instanceWidget = new QWidget(this);
+    m_instanceWidget->setLayout(instanceLayout);
+    m_instanceWidget->setEnabled(false);
+
+    m_candidateBox = new QComboBox(this);
+    m_candidateBox->setToolTip("The challenge structure found in the game memory whose rules are displayed and changed");
+    m_candidateBox->setMinimumWidth(250);
+
+    auto candidateLayout = new QHBoxLayout();
+    candidateLayout->addWidget(new QLabel("Structure:"));
+    candidateLayout->addWidget(m_candidateBox);
+
+    m_candidateWidget = new QWidget(this);
+    m_candidateWidget->setLayout(candidateLayout);
+    m_candidateWidget->setEnabled(false);
+
     m_loadButton = new QPushButton("Load challenge", this);
     m_loadButton->setToolTip("Loads the current challenge and displays its rules");
     m_loadButton->setFixedSize(140, 30);
     m_loadButton->setFont(QFont(m_loadButton->font().defaultFamily(), 10));
 
+    m_cancelButton = new QPushButton("Cancel", this);
+    m_cancelButton->setFixedSize(140, 30);
+    m_cancelButton->setFont(QFont(m_cancelButton->font().defaultFamily(), 10));
+    m_cancelButton->hide();
+
     m_levelLabel = new QLabel("Level: N/A");
     m_levelLabel->setMargin(5);
     m_levelLabel->setEnabled(false);
@@ -161,16 +211,19 @@ MainFrame::MainFrame(const std::string &exePath)
 
     auto challengeLayout = new QGridLayout();
     challengeLayout->addWidget(m_loadButton, 0, 0, 1, 2, Qt::AlignCenter);
+    challengeLayout->addWidget(m_cancelButton, 0, 0, 1, 2, Qt::AlignCenter);
     challengeLayout->addWidget(m_loadingLabel, 0, 1, Qt::AlignCenter);
-    challengeLayout->addWidget(m_levelLabel, 1, 0, 1, 2, Qt::AlignCenter);
-    challengeLayout->addWidget(m_eventLabel, 2, 0, Qt::AlignCenter);
-    challengeLayout->addWidget(m_difficultyLabel, 2, 1, Qt::AlignCenter);
-    challengeLayout->addWidget(m_seedWidget, 3, 0, Qt::AlignRight);
-    challengeLayout->addWidget(m_randomWidget, 3, 1, Qt::AlignLeft);
-    challengeLayout->addWidget(m_goalWidget, 4, 0);
-    challengeLayout->addWidget(m_limitWidget, 4, 1);
-    challengeLayout->addWidget(m_applyButton, 5, 0, Qt::AlignRight);
-    challengeLayout->addWidget(m_resetButton, 5, 1, Qt::AlignLeft);
+    challengeLayout->addWidget(m_instanceWidget, 1, 0, 1, 2, Qt::AlignCenter);
+    challengeLayout->addWidget(m_candidateWidget, 2, 0, 1, 2, Qt::AlignCenter);
+    challengeLayout->addWidget(m_levelLabel, 3, 0, 1, 2, Qt::AlignCenter);
+    challengeLayout->addWidget(m_eventLabel, 4, 0, Qt::AlignCenter);
+    challengeLayout->addWidget(m_difficultyLabel, 4, 1, Qt::AlignCenter);
+    challengeLayout->addWidget(m_seedWidget, 5, 0, Qt::AlignRight);
+    challengeLayout->addWidget(m_randomWidget, 5, 1, Qt::AlignLeft);
+    challengeLayout->addWidget(m_goalWidget, 6, 0);
+    challengeLayout->addWidget(m_limitWidget, 6, 1);
+    challengeLayout->addWidget(m_applyButton, 7, 0, Qt::AlignRight);
+    challengeLayout->addWidget(m_resetButton, 7, 1, Qt::AlignLeft);
 
     auto challengeGroup = new QGroupBox("Challenge");
     challengeGroup->setLayout(challengeLayout);
@@ -225,6 +278,11 @@ MainFrame::MainFrame(const std::string &exePath)
 
     cout << "RL® Challenge Manager (2.0.b4)" << endl << "© 2014-2016 Olybri" << endl << endl;
 
+    const auto exeFolder = exePath.substr(0, exePath.find_last_of("/\\") + 1);
+    m_challenges.setAddressCacheFile(exeFolder + "addresses.sav");
+    m_challenges.setRegionStatsFile(exeFolder + "regions.sav");
+    m_challenges.setPointerChainFile(exeFolder + "pointers.txt");
+
     try
     {
         m_gameFolder = getGameFolder(exePath);
@@ -240,11 +298,36 @@ MainFrame::MainFrame(const std::string &exePath)
         m_trainingCheck->setEnabled(false);
     }
 
+    m_watcher = new ChallengeWatcher(m_challenges, this);
+
+    m_reloadTimer.setSingleShot(true);
+
+    // called from the loading thread, the signal is queued to the GUI thread
+    m_challenges.setProgressCallback([this](const ScanProgress &progress)
+    {
+        emit scanProgressed(progress.scannedSize, progress.totalSize, progress.remainingBlocks, progress.candidateCount);
+    });
+
     /// CONNECTIONS
 
     connect(m_loadButton, SIGNAL(clicked()), m_loadChallengeAction, SLOT(trigger()));
     connect(m_loadChallengeAction, SIGNAL(triggered()), this, SLOT(loadChallenge()));
     connect(&m_loadWatcher, SIGNAL(finished()), this, SLOT(onLoadChallengeFinished()));
+    connect(m_cancelButton, SIGNAL(clicked()), m_cancelLoadingAction, SLOT(trigger()));
+    connect(m_cancelLoadingAction, SIGNAL(triggered()), this, SLOT(cancelLoading()));
+    connect(this, SIGNAL(scanProgressed(qulonglong,qulonglong,qulonglong,qulonglong)),
+        this, SLOT(showScanProgress(qulonglong,qulonglong,qulonglong,qulonglong)));
+
+    connect(m_watcher, SIGNAL(challengeChanged(int)), this, SLOT(onChallengeChanged(int)));
+    connect(m_watcher, SIGNAL(challengeLost(int)), this, SLOT(onChallengeLost(int)));
+    connect(&m_reloadTimer, SIGNAL(timeout()), this, SLOT(reloadChallenge()));
+    connect(m_instanceBox, SIGNAL(currentIndexChanged(int)), this, SLOT(selectInstance(int)));
+    connect(m_candidateBox, SIGNAL(activated(int)), this, SLOT(selectCandidate(int)));
+
+    connect(openSnapshotAction, SIGNAL(triggered()), this, SLOT(openSnapshot()));
+    connect(m_saveSnapshotAction, SIGNAL(triggered()), this, SLOT(saveSnapshot()));
+    connect(&m_snapshotWatcher, SIGNAL(finished()), this, SLOT(onSaveSnapshotFinished()));
+    connect(m_exportStatsAction, SIGNAL(triggered()), this, SLOT(exportStats()));
 
     connect(m_randomButton, SIGNAL(clicked()), this, SLOT(generateRandomSeed()));
 
@@ -301,12 +384,41 @@ QString MainFrame::loadChallengeThread()
 {
     m_trainingWatcher.waitForFinished();
 
+    m_snapshotWatcher.waitForFinished();
+
+    // a snapshot is only used once, the next loads read the game again
+    const auto snapshotFilename = m_snapshotFilename;
+    m_snapshotFilename.clear();
+
     try
     {
         Clock clock;
-        m_challenge.openProcess(m_gameFolder + gameName);
-        m_challenge.load();
+        if(snapshotFilename.empty())
+            m_challenges.openProcesses(m_gameFolder + gameName);
+        else
+            m_challenges.openSnapshot(snapshotFilename);
+
+        // the instances are loaded in parallel
+        const auto loadedCount = m_challenges.load();
         cout << clock.elapsed() << " seconds elapsed." << endl;
+
+        const auto instanceCount = m_challenges.getInstanceCount();
+        for(std::size_t i = 0; i < instanceCount; ++i)
+        {
+            auto &challenge = m_challenges.getInstance(i);
+            if(instanceCount > 1)
+            {
+                cout << endl << "Process " << std::dec << challenge.getProcessId() << ":" << endl;
+                if(!m_challenges.isLoaded(i))
+                    cerr << m_challenges.getError(i) << endl;
+            }
+
+            challenge.getStats().print(cout);
+        }
+
+        // the instances which failed are only listed if another one was loaded
+        if(loadedCount == 0)
+            return m_challenges.getError(0).c_str();
     }
 
     catch(const std::exception &e)
@@ -319,53 +431,349 @@ QString MainFrame::loadChallengeThread()
 
 void MainFrame::loadChallenge()
 {
+    // the challenge is used by the loading thread
+    m_watcher->stop();
+    m_reloadTimer.stop();
+
     m_loadChallengeAction->setEnabled(false);
+    m_exportStatsAction->setEnabled(false);
     m_loadButton->setEnabled(false);
     m_applyButton->setEnabled(false);
     m_resetButton->setEnabled(false);
+    m_instanceWidget->setEnabled(false);
+    m_candidateWidget->setEnabled(false);
 
     m_loadingLabel->show();
     m_loadingMovie->start();
 
+    m_loadButton->hide();
+    m_cancelButton->setText("Cancel");
+    m_cancelButton->setToolTip("Stops loading the challenge");
+    m_cancelButton->setEnabled(true);
+    m_cancelButton->show();
+    m_cancelLoadingAction->setEnabled(true);
+
+    m_challenges.startScans();
     m_loadWatcher.setFuture(QtConcurrent::run(this, &MainFrame::loadChallengeThread));
 }
 
+void MainFrame::cancelLoading()
+{
+    // the scan stops after its current blocks, 'onLoadChallengeFinished' follows shortly
+    m_challenges.cancelScans();
+
+    m_cancelButton->setEnabled(false);
+    m_cancelLoadingAction->setEnabled(false);
+}
+
+void MainFrame::showScanProgress(qulonglong scannedSize, qulonglong totalSize, qulonglong remainingBlocks, qulonglong candidateCount)
+{
+    if(totalSize == 0)
+        return;
+
+    m_cancelButton->setText(QString("Cancel (%1%)").arg(scannedSize * 100 / totalSize));
+    m_cancelButton->setToolTip(QString("%1 / %2 MiB scanned, %3 blocks left, %4 candidates found")
+        .arg(scannedSize / 0x10'0000).arg(totalSize / 0x10'0000).arg(remainingBlocks).arg(candidateCount));
+}
+
 void MainFrame::onLoadChallengeFinished()
 {
     m_goalLine->setFixedSize(m_goalLine->size());
     m_limitLine->setFixedSize(m_limitLine->size());
 
     m_loadChallengeAction->setEnabled(true);
+    m_exportStatsAction->setEnabled(true);
     m_loadButton->setEnabled(true);
 
     m_loadingLabel->hide();
 
+    m_cancelButton->hide();
+    m_cancelLoadingAction->setEnabled(false);
+    m_loadButton->show();
+
+    showInstances();
+
+    const bool automatic = m_automaticLoad;
+    m_automaticLoad = false;
+
     auto result = m_loadWatcher.future().result();
+    if(!result.isEmpty() && m_challenges.isCancelled())
+    {
+        // the user asked for it, no need to show an error
+        cout << result << endl;
+        return;
+    }
+
+    if(!result.isEmpty() && automatic)
+    {
+        // the player is likely on a menu, the next challenge is waited for
+        cerr << result << endl;
+        cout << "Loading the challenge again in " << std::dec << m_reloadInterval / 1000 << " seconds..." << endl;
+
+        m_reloadTimer.start(m_reloadInterval);
+        m_reloadInterval = std::min(m_reloadInterval * 2, maxReloadInterval);
+        return;
+    }
+
     if(!result.isEmpty())
     {
         showError(result);
         return;
     }
 
-    m_levelLabel->setEnabled(true);
-    m_eventLabel->setEnabled(true);
-    m_difficultyLabel->setEnabled(true);
-    m_seedWidget->setEnabled(true);
-    m_randomWidget->setEnabled(true);
+    m_watcher->start();
+}
 
-    m_goalWidget->setEnabled(!m_challenge.getGoalType().empty());
-    m_limitWidget->setEnabled(true);
+void MainFrame::onChallengeChanged(int index)
+{
+    updateInstanceItem(static_cast<std::size_t>(index));
 
-    m_goalTypeLabel->setText(m_challenge.getGoalType().c_str());
-    m_limitTypeLabel->setText(m_challenge.getLimitType().c_str());
+    if(static_cast<std::size_t>(index) != m_selectedInstance)
+        return;
 
-    m_levelLabel->setText(QString("Level: ") + m_challenge.getLevelName().c_str());
-    m_eventLabel->setText(QString("Event: ") + m_challenge.getEventName().c_str());
-    m_difficultyLabel->setText(QString("Difficulty: ") + m_challenge.getDifficultyName().c_str());
+    showRules();
+    resetChanges();
+}
+
+void MainFrame::onChallengeLost(int)
+{
+    // the structures have been freed or reused, they are searched again
+    // the other instances only check their cached addresses
+    m_reloadInterval = minReloadInterval;
+    reloadChallenge();
+}
+
+void MainFrame::reloadChallenge()
+{
+    // a load started in the meantime replaces this one
+    if(m_loadWatcher.isRunning() || m_watcher->isActive())
+        return;
+
+    m_automaticLoad = true;
+    loadChallenge();
+}
+
+void MainFrame::selectInstance(int index)
+{
+    if(index < 0)
+        return;
+
+    m_selectedInstance = static_cast<std::size_t>(index);
+
+    showRules();
+    resetChanges();
+}
+
+void MainFrame::selectCandidate(int index)
+{
+    const auto challenge = getSelectedChallenge();
+    if(challenge == nullptr || index < 0)
+        return;
+
+    try
+    {
+        challenge->selectCandidate(static_cast<std::size_t>(index));
+    }
+    catch(const std::exception &e)
+    {
+        showError(e.what());
+    }
 
+    updateInstanceItem(m_selectedInstance);
+    showRules();
     resetChanges();
 }
 
+void MainFrame::showInstances()
+{
+    const auto selectedId = m_instanceBox->currentData();
+    const auto instanceCount = m_challenges.getInstanceCount();
+
+    {
+        // the instance is selected once the list is complete
+        const QSignalBlocker blocker(m_instanceBox);
+
+        m_instanceBox->clear();
+        for(std::size_t i = 0; i < instanceCount; ++i)
+        {
+            m_instanceBox->addItem("");
+            updateInstanceItem(i);
+        }
+
+        // the same process stays selected, otherwise the first loaded instance is
+        auto index = m_instanceBox->findData(selectedId);
+        for(std::size_t i = 0; index < 0 && i < instanceCount; ++i)
+            if(m_challenges.isLoaded(i))
+                index = static_cast<int>(i);
+
+        m_instanceBox->setCurrentIndex(std::max(index, 0));
+    }
+
+    m_instanceWidget->setEnabled(instanceCount > 1);
+    selectInstance(m_instanceBox->currentIndex());
+}
+
+void MainFrame::updateInstanceItem(std::size_t index)
+{
+    auto &challenge = m_challenges.getInstance(index);
+    auto text = QString("Process %1").arg(challenge.getProcessId());
+
+    if(m_challenges.isLoaded(index))
+        text += QString(": ") + challenge.getLevelName().c_str() + ", " + challenge.getDifficultyName().c_str();
+    else
+        text += " (not loaded)";
+
+    const auto item = static_cast<int>(index);
+    m_instanceBox->setItemText(item, text);
+    m_instanceBox->setItemData(item, challenge.getProcessId());
+    m_instanceBox->setItemData(item, m_challenges.getError(index).c_str(), Qt::ToolTipRole);
+}
+
+Challenge* MainFrame::getSelectedChallenge() noexcept
+{
+    if(m_selectedInstance >= m_challenges.getInstanceCount() || !m_challenges.isLoaded(m_selectedInstance))
+        return nullptr;
+
+    return &m_challenges.getInstance(m_selectedInstance);
+}
+
+void MainFrame::showRules()
+{
+    const auto challenge = getSelectedChallenge();
+    const bool loaded = challenge != nullptr;
+
+    m_levelLabel->setEnabled(loaded);
+    m_eventLabel->setEnabled(loaded);
+    m_difficultyLabel->setEnabled(loaded);
+    m_seedWidget->setEnabled(loaded);
+    m_randomWidget->setEnabled(loaded);
+
+    m_goalWidget->setEnabled(loaded && !challenge->getGoalType().empty());
+    m_limitWidget->setEnabled(loaded);
+
+    showCandidates();
+
+    if(!loaded)
+    {
+        m_levelLabel->setText("Level: N/A");
+        m_eventLabel->setText("Event: N/A");
+        m_difficultyLabel->setText("Difficulty: N/A");
+        return;
+    }
+
+    m_goalTypeLabel->setText(challenge->getGoalType().c_str());
+    m_limitTypeLabel->setText(challenge->getLimitType().c_str());
+
+    m_levelLabel->setText(QString("Level: ") + challenge->getLevelName().c_str());
+    m_eventLabel->setText(QString("Event: ") + challenge->getEventName().c_str());
+    m_difficultyLabel->setText(QString("Difficulty: ") + challenge->getDifficultyName().c_str());
+}
+
+void MainFrame::showCandidates()
+{
+    const auto challenge = getSelectedChallenge();
+
+    // the list is filled again without selecting anything
+    const QSignalBlocker blocker(m_candidateBox);
+    m_candidateBox->clear();
+
+    if(challenge == nullptr)
+    {
+        m_candidateWidget->setEnabled(false);
+        return;
+    }
+
+    const auto &candidates = challenge->getCandidates();
+    for(std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        const auto &candidate = candidates[i];
+        const auto item = static_cast<int>(i);
+
+        m_candidateBox->addItem(QString("%1 (seed: %2)").arg(candidate.isg.c_str())
+            .arg(QString::number(candidate.seed, 16).toUpper().rightJustified(8, '0')));
+
+        m_candidateBox->setItemData(item, QString("Address: 0x%1\nSeed copies match: %2\nKnown ISG filename: %3\nLikely region: %4")
+            .arg(static_cast<qulonglong>(candidate.addresses[1]), 0, 16)
+            .arg(candidate.seedCopiesMatch ? "yes" : "no")
+            .arg(candidate.isgValid ? "yes" : "no")
+            .arg(candidate.likelyRegion ? "yes" : "no"), Qt::ToolTipRole);
+
+        // a structure whose seed copies differ is stale, it is listed but can't be chosen
+        if(!candidate.seedCopiesMatch)
+            qobject_cast<QStandardItemModel*>(m_candidateBox->model())->item(item)->setEnabled(false);
+    }
+
+    m_candidateBox->setCurrentIndex(static_cast<int>(challenge->getSelectedCandidate()));
+    m_candidateWidget->setEnabled(candidates.size() > 1);
+}
+
+void MainFrame::openSnapshot()
+{
+    auto filename = QFileDialog::getOpenFileName(this, "Open memory snapshot", "", "Memory snapshots (*.rlsnap);;All files (*)");
+    if(filename.isEmpty())
+        return;
+
+    m_snapshotFilename = filename.toStdString();
+    loadChallenge();
+}
+
+QString MainFrame::saveSnapshotThread(const QString &filename)
+{
+    m_loadWatcher.waitForFinished();
+
+    try
+    {
+        if(m_selectedInstance >= m_challenges.getInstanceCount())
+            throw std::runtime_error("No process is open.");
+
+        Clock clock;
+        m_challenges.getInstance(m_selectedInstance).saveSnapshot(filename.toStdString());
+        cout << clock.elapsed() << " seconds elapsed." << endl;
+    }
+    catch(const std::exception &e)
+    {
+        return e.what();
+    }
+
+    return "";
+}
+
+void MainFrame::saveSnapshot()
+{
+    auto filename = QFileDialog::getSaveFileName(this, "Save memory snapshot", "", "Memory snapshots (*.rlsnap)");
+    if(filename.isEmpty())
+        return;
+
+    m_saveSnapshotAction->setEnabled(false);
+    m_snapshotWatcher.setFuture(QtConcurrent::run(this, &MainFrame::saveSnapshotThread, filename));
+}
+
+void MainFrame::onSaveSnapshotFinished()
+{
+    m_saveSnapshotAction->setEnabled(true);
+
+    auto result = m_snapshotWatcher.future().result();
+    if(!result.isEmpty())
+        showError(result);
+}
+
+void MainFrame::exportStats()
+{
+    if(m_selectedInstance >= m_challenges.getInstanceCount())
+        return;
+
+    auto filename = QFileDialog::getSaveFileName(this, "Export load statistics", "", "JSON files (*.json);;All files (*)");
+    if(filename.isEmpty())
+        return;
+
+    // the statistics of the selected instance
+    std::ofstream ofs(filename.toStdString(), std::ios::out | std::ios::trunc);
+    ofs << m_challenges.getInstance(m_selectedInstance).getStats().toJson();
+
+    if(!ofs)
+        showError("Failed to export load statistics into file \"" + filename + "\"!");
+}
+
 QString MainFrame::installTrainingRoomThread(bool install)
 {
     m_loadWatcher.waitForFinished();
@@ -417,12 +825,20 @@ void MainFrame::generateRandomSeed()
 
 void MainFrame::enableButtons()
 {
+    const auto challenge = getSelectedChallenge();
+    if(challenge == nullptr)
+    {
+        m_applyButton->setEnabled(false);
+        m_resetButton->setEnabled(false);
+        return;
+    }
+
     bool enabled = false;
 
     const QString changedStyle = "color:red";
     const QString unchangedStyle = "color:black";
 
-    if(stringToSeed(m_seedLine->displayText()) != m_challenge.getSeed())
+    if(stringToSeed(m_seedLine->displayText()) != challenge->getSeed())
     {
         m_seedLine->setStyleSheet(changedStyle);
         enabled = true;
@@ -432,7 +848,7 @@ void MainFrame::enableButtons()
 
     if(m_goalWidget->isEnabled())
     {
-        if(!m_goalLine->valueEquals(m_challenge.getGoal()))
+        if(!m_goalLine->valueEquals(challenge->getGoal()))
         {
             m_goalLine->setStyleSheet(changedStyle);
             enabled = true;
@@ -443,7 +859,7 @@ void MainFrame::enableButtons()
     else
         m_goalLine->setStyleSheet("");
 
-    if(!m_limitLine->valueEquals(m_challenge.getLimit()))
+    if(!m_limitLine->valueEquals(challenge->getLimit()))
     {
         m_limitLine->setStyleSheet(changedStyle);
         enabled = true;
@@ -457,28 +873,46 @@ void MainFrame::enableButtons()
 
 void MainFrame::applyChanges()
 {
+    const auto challenge = getSelectedChallenge();
+    if(challenge == nullptr)
+        return;
+
     auto seed = stringToSeed(m_seedLine->displayText());
 
-    if(seed != m_challenge.getSeed())
+    if(seed != challenge->getSeed())
         easterEgg(seed);
 
-    try
+    // the instances are updated in parallel
+    const auto index = m_applyToAllCheck->isChecked() ? ChallengeGroup::all : m_selectedInstance;
+    if(!m_challenges.updateRules(index, seed, m_goalLine->value(), m_limitLine->value()))
     {
-        m_challenge.updateRules(seed, m_goalLine->value(), m_limitLine->value());
+        QString errors;
+        for(std::size_t i = 0; i < m_challenges.getInstanceCount(); ++i)
+        {
+            if(m_challenges.getError(i).empty() || (index != i && (index != ChallengeGroup::all || !m_challenges.isLoaded(i))))
+                continue;
 
-        enableButtons();
-    }
-    catch(const std::exception &e)
-    {
-        showError(e.what());
+            if(m_challenges.getInstanceCount() > 1)
+                errors += QString("Process %1: ").arg(m_challenges.getInstance(i).getProcessId());
+
+            errors += QString(m_challenges.getError(i).c_str()) + "\n";
+        }
+
+        showError(errors.trimmed());
     }
+
+    enableButtons();
 }
 
 void MainFrame::resetChanges()
 {
-    m_seedLine->setText(seedToString(m_challenge.getSeed()));
-    m_goalLine->setValue(m_challenge.getGoal());
-    m_limitLine->setValue(m_challenge.getLimit());
+    const auto challenge = getSelectedChallenge();
+    if(challenge == nullptr)
+        return;
+
+    m_seedLine->setText(seedToString(challenge->getSeed()));
+    m_goalLine->setValue(challenge->getGoal());
+    m_limitLine->setValue(challenge->getLimit());
 }
 
 void MainFrame::showLastSeed()
@@ -527,60 +961,6 @@ void MainFrame::showLastSeed()
         seedToString(seed), "Last challenge seed", QMessageBox::Information);
 }
 
-std::string MainFrame::getGameFolder(const std::string &exePath)
-{
-    std::string gameFolder;
-
-    auto saveFilename = exePath.substr(0, exePath.find_last_of('\\') + 1) + "gamedir.sav";
-    std::ifstream ifs(saveFilename);
-    if(ifs)
-    {
-        std::ostringstream str;
-        str << ifs.rdbuf();
-        gameFolder = str.str();
-
-        ifs.close();
-    }
-
-    if(!gameFolder.empty())
-        cout << "Game directory:" << endl << gameFolder << endl;
-
-    else
-    {
-        gameFolder = locateGameFolder();
-
-        std::ofstream ofs(saveFilename, std::ios::out | std::ios::trunc);
-        if(ofs)
-        {
-            ofs << gameFolder;
-            ofs.close();
-        }
-
-        else
-            cerr << "Warning: Failed to save game directory into file \"" << saveFilename << "\"!" << endl;
-    }
-
-    return gameFolder;
-}
-
-std::string MainFrame::locateGameFolder()
-{
-    cout << "Locating game directory... " << flush;
-
-    auto gameFolder = Process::getProcessLocation(gameName);
-
-    if(gameFolder.empty())
-    {
-        cout << "Failure!" << endl;
-        throw std::runtime_error("Can't locate the game directory because \"" + gameName + "\" is not running!\n"
-            + "Please launch the game.");
-    }
-
-    cout << "Success!" << endl << "Found: " << gameFolder << endl;
-
-    return gameFolder;
-}
-
 QString MainFrame::seedToString(unsigned seed)
 {
     std::ostringstream str;
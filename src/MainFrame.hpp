@@ -9,6 +9,7 @@
 #include <QVBoxLayout>
 #include <QPushButton>
 #include <QCheckBox>
+#include <QComboBox>
 #include <QLabel>
 #include <QDockWidget>
 #include <QListWidget>
@@ -23,9 +24,15 @@
 #include <QMenu>
 #include <QMovie>
 #include <QMenuBar>
+#include <QFileDialog>
+#include <QStandardItemModel>
+#include <QTimer>
 
 #include "Challenge.hpp"
+#include "ChallengeGroup.hpp"
+#include "ChallengeWatcher.hpp"
 #include "Bundle.hpp"
+#include "GameFolder.hpp"
 #include "OutputStream.hpp"
 #include "SpinBox.hpp"
 #include "Clock.hpp"
@@ -42,11 +49,10 @@ class MainFrame : public QMainWindow
 
     public:
         MainFrame(const std::string &exePath);
-        std::string getGameFolder(const std::string &exePath);
-        std::string locateGameFolder();
 
         QString loadChallengeThread();
         QString installTrainingRoomThread(bool install);
+        QString saveSnapshotThread(const QString &filename);
 
         void showMessage(const QString &msg, const QString &copiable, const QString &title, QMessageBox::Icon icon);
         void showError(const QString &error);
@@ -58,6 +64,8 @@ class MainFrame : public QMainWindow
         void easterEgg(unsigned seed);
 
     signals:
+        // progress of the scans of the loading thread
+        void scanProgressed(qulonglong scannedSize, qulonglong totalSize, qulonglong remainingBlocks, qulonglong candidateCount);
 
     public slots:
         void showOutput(bool show);
@@ -65,6 +73,24 @@ class MainFrame : public QMainWindow
 
         void loadChallenge();
         void onLoadChallengeFinished();
+        void cancelLoading();
+        void showScanProgress(qulonglong scannedSize, qulonglong totalSize, qulonglong remainingBlocks, qulonglong candidateCount);
+
+        void onChallengeChanged(int index);
+        void onChallengeLost(int index);
+
+        // loads the challenge without showing its errors, it is tried again later if it fails
+        void reloadChallenge();
+
+        // displays the rules of the instance 'index' of the challenge group
+        void selectInstance(int index);
+        void selectCandidate(int index);
+
+        void openSnapshot();
+        void saveSnapshot();
+        void onSaveSnapshotFinished();
+
+        void exportStats();
 
         void installTrainingRoom(bool install);
         void onInstallTrainingRoomFinished();
@@ -78,8 +104,34 @@ class MainFrame : public QMainWindow
         void showLastSeed();
 
     private:
+        // displays the rules of the selected instance
+        void showRules();
+
+        // returns the selected instance, or nullptr if it isn't loaded
+        Challenge* getSelectedChallenge() noexcept;
+
+        // fills the instance list after a load, the instance selected before stays selected
+        void showInstances();
+
+        // fills the list of the challenge structures found in the selected instance
+        void showCandidates();
+
+        // writes the process ID and the state of the instance 'index' into the instance list
+        void updateInstanceItem(std::size_t index);
+
+        QWidget *m_instanceWidget;
+        QComboBox *m_instanceBox;
+        QCheckBox *m_applyToAllCheck;
+
+        QWidget *m_candidateWidget;
+        QComboBox *m_candidateBox;
+
         QPushButton *m_loadButton;
+        QPushButton *m_cancelButton;
         QAction *m_loadChallengeAction;
+        QAction *m_cancelLoadingAction;
+        QAction *m_saveSnapshotAction;
+        QAction *m_exportStatsAction;
 
         QLabel *m_levelLabel;
         QLabel *m_eventLabel;
@@ -113,16 +165,28 @@ class MainFrame : public QMainWindow
 
         QFutureWatcher<QString> m_loadWatcher;
         QFutureWatcher<QString> m_trainingWatcher;
+        QFutureWatcher<QString> m_snapshotWatcher;
+
+        // one challenge per running instance of the game
+        ChallengeGroup m_challenges;
+        std::size_t m_selectedInstance {0};
+        ChallengeWatcher *m_watcher;
+
+        // the load started by 'reloadChallenge' is retried with a growing interval while it fails
+        QTimer m_reloadTimer;
+        int m_reloadInterval {minReloadInterval};
+        bool m_automaticLoad {false};
 
-        Challenge m_challenge;
+        static const int minReloadInterval {2000};
+        static const int maxReloadInterval {30000};
         std::string m_gameFolder;
 
-        const std::string gameName = "Rayman Legends.exe";
-        const std::string bundleName = "Bundle_PC.ipk";
+        // the snapshot loaded instead of the game by the next 'loadChallengeThread'
+        std::string m_snapshotFilename;
 
         const unsigned windowWidth = 424;
-        const unsigned windowHeight = 347;
-        const unsigned altWindowHeight = 521;
+        const unsigned windowHeight = 412;
+        const unsigned altWindowHeight = 586;
 };
 
 #endif // MAINFRAME_H
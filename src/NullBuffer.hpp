@@ -0,0 +1,16 @@
+#ifndef NULLBUFFER_H
+#define NULLBUFFER_H
+
+#include <streambuf>
+
+// a stream buffer which drops what is written into it, to hide the progress messages
+class NullBuffer : public std::streambuf
+{
+    protected:
+        int_type overflow(int_type c) override
+        {
+            return traits_type::not_eof(c);
+        }
+};
+
+#endif // NULLBUFFER_H
@@ -0,0 +1,85 @@
+#include "OccurrenceIndex.hpp"
+
+#include <algorithm>
+
+void OccurrenceIndex::build(Process &process, const PatternSet &anchors, Address first, Address last)
+{
+    build(anchors, process.findStrings(anchors, first, last));
+}
+
+void OccurrenceIndex::build(Process &process, const PatternSet &anchors, const std::vector<MemoryRegion> &regions)
+{
+    build(anchors, process.findStrings(anchors, regions));
+}
+
+void OccurrenceIndex::build(const PatternSet &anchors, const std::vector<StringMatch> &matches)
+{
+    clear();
+
+    for(std::size_t i = 0; i < anchors.size(); ++i)
+        m_anchors.push_back(anchors.getPattern(i));
+
+    m_occurrences.resize(anchors.size());
+
+    // the matches are sorted by address, so is every list
+    for(const auto &match : matches)
+        m_occurrences[match.pattern].push_back(match.address);
+}
+
+void OccurrenceIndex::clear() noexcept
+{
+    m_anchors.clear();
+    m_occurrences.clear();
+}
+
+const std::vector<Address>& OccurrenceIndex::getOccurrences(std::size_t anchor) const noexcept
+{
+    return m_occurrences[anchor];
+}
+
+bool OccurrenceIndex::canFind(const std::string &str) const noexcept
+{
+    return std::any_of(m_anchors.begin(), m_anchors.end(),
+        [&str](const std::string &anchor){ return str.find(anchor) != std::string::npos; });
+}
+
+std::vector<Address> OccurrenceIndex::find(Process &process, const std::string &str, Address first, Address last) const
+{
+    std::vector<Address> addresses;
+
+    // the anchor having the fewest occurrences gives the fewest candidates
+    std::size_t anchor {m_anchors.size()};
+    std::size_t offset {0};
+
+    for(std::size_t i = 0; i < m_anchors.size(); ++i)
+    {
+        const auto position = str.find(m_anchors[i]);
+        if(position != std::string::npos
+            && (anchor == m_anchors.size() || m_occurrences[i].size() < m_occurrences[anchor].size()))
+        {
+            anchor = i;
+            offset = position;
+        }
+    }
+
+    if(anchor == m_anchors.size())
+        return addresses;
+
+    std::vector<Address> candidates;
+    for(auto address : m_occurrences[anchor])
+        if(address >= offset && address - offset >= first && address - offset < last)
+            candidates.push_back(address - offset);
+
+    std::vector<char> data(candidates.size() * str.size());
+    std::vector<ReadRequest> requests;
+    for(std::size_t i = 0; i < candidates.size(); ++i)
+        requests.push_back({candidates[i], data.data() + i * str.size(), str.size()});
+
+    process.readBatch(requests.data(), requests.size());
+
+    for(const auto &request : requests)
+        if(request.success && std::equal(str.begin(), str.end(), request.buffer))
+            addresses.push_back(request.address);
+
+    return addresses;
+}
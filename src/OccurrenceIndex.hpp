@@ -0,0 +1,42 @@
+#ifndef OCCURRENCEINDEX_H
+#define OCCURRENCEINDEX_H
+
+#include <string>
+#include <vector>
+
+#include "Process.hpp"
+
+// Every occurrence of a set of anchor strings in the process memory, found by
+// a single pass. A string which contains one of the anchors can then be looked
+// for without traversing the memory again: only the places where this anchor
+// occurs are read.
+class OccurrenceIndex
+{
+    public:
+        // finds the occurrences of 'anchors' between 'first' and 'last'
+        // the previous occurrences are forgotten
+        void build(Process &process, const PatternSet &anchors, Address first = 0, Address last = Process::npos);
+
+        // same as above, but only 'regions' are searched, they must be sorted by address
+        void build(Process &process, const PatternSet &anchors, const std::vector<MemoryRegion> &regions);
+
+        void clear() noexcept;
+
+        // returns the occurrences of the anchor 'anchor', sorted by address
+        const std::vector<Address>& getOccurrences(std::size_t anchor) const noexcept;
+
+        // returns true if 'str' contains one of the anchors, so that 'find' can look for it
+        bool canFind(const std::string &str) const noexcept;
+
+        // returns the occurrences of 'str' starting between 'first' and 'last', sorted by address
+        // the places where the least frequent anchor of 'str' occurs are read at once
+        std::vector<Address> find(Process &process, const std::string &str, Address first = 0, Address last = Process::npos) const;
+
+    private:
+        void build(const PatternSet &anchors, const std::vector<StringMatch> &matches);
+
+        std::vector<std::string> m_anchors;
+        std::vector<std::vector<Address>> m_occurrences;
+};
+
+#endif // OCCURRENCEINDEX_H
@@ -29,7 +29,9 @@ void OutputStream::scrollToBottom()
 }
 
 OutputStream::int_type OutputStream::overflow(OutputStream::int_type ch)
-{    
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     if(ch == '\n')
     {
         addLine(m_buffer);
@@ -42,6 +44,8 @@ OutputStream::int_type OutputStream::overflow(OutputStream::int_type ch)
 
 std::streamsize OutputStream::xsputn(char const *s, std::streamsize count)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     QString str = QString(s).left(count);
 
     if(str.contains("\n"))
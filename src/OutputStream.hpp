@@ -4,6 +4,7 @@
 #include <QListWidget>
 
 #include <iostream>
+#include <mutex>
 
 class ListWidget : public QListWidget
 {
@@ -31,6 +32,8 @@ class OutputStream : public std::basic_streambuf<char>
         virtual std::streamsize xsputn(char const *s, std::streamsize count) override;
 
     private:
+        // the instances of the game are loaded by several threads
+        std::mutex m_mutex;
         QString m_buffer;
         ListWidget *m_output;
         QColor m_color;
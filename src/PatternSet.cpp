@@ -0,0 +1,96 @@
+#include "PatternSet.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <queue>
+
+PatternSet::PatternSet(const std::vector<std::string> &patterns) :
+    m_patterns(patterns)
+{
+    // trie of the patterns, state 0 being the root
+    std::vector<std::vector<State>> children(1, std::vector<State>(0x100, 0));
+    std::vector<std::vector<std::size_t>> outputs(1);
+
+    for(std::size_t index = 0; index < m_patterns.size(); ++index)
+    {
+        const auto &pattern = m_patterns[index];
+        assert(!pattern.empty());
+
+        m_maxLength = std::max(m_maxLength, pattern.size());
+        if(m_firstBytes.find(pattern.front()) == std::string::npos)
+            m_firstBytes += pattern.front();
+
+        State state {0};
+        for(auto c : pattern)
+        {
+            auto &child = children[state][static_cast<unsigned char>(c)];
+            if(child == 0)
+            {
+                child = static_cast<State>(children.size());
+                children.emplace_back(0x100, 0);
+                outputs.emplace_back();
+            }
+
+            state = child;
+        }
+
+        outputs[state].push_back(index);
+    }
+
+    // breadth-first traversal which turns the trie into a complete automaton:
+    // a missing transition leads where the failure state would have led
+    std::vector<State> failure(children.size(), 0);
+    std::queue<State> queue;
+
+    for(auto child : children[0])
+        if(child != 0)
+            queue.push(child);
+
+    while(!queue.empty())
+    {
+        const auto state = queue.front();
+        queue.pop();
+
+        const auto &failureOutputs = outputs[failure[state]];
+        outputs[state].insert(outputs[state].end(), failureOutputs.begin(), failureOutputs.end());
+
+        for(std::size_t c = 0; c < 0x100; ++c)
+        {
+            auto &child = children[state][c];
+            if(child != 0)
+            {
+                failure[child] = children[failure[state]][c];
+                queue.push(child);
+            }
+            else
+                child = children[failure[state]][c];
+        }
+    }
+
+    m_transitions.reserve(children.size() * 0x100);
+    m_outputOffsets.reserve(children.size() + 1);
+
+    for(std::size_t state = 0; state < children.size(); ++state)
+    {
+        m_transitions.insert(m_transitions.end(), children[state].begin(), children[state].end());
+        m_outputOffsets.push_back(m_outputs.size());
+        m_outputs.insert(m_outputs.end(), outputs[state].begin(), outputs[state].end());
+    }
+
+    m_outputOffsets.push_back(m_outputs.size());
+}
+
+std::size_t PatternSet::size() const noexcept
+{
+    return m_patterns.size();
+}
+
+const std::string& PatternSet::getPattern(std::size_t index) const noexcept
+{
+    return m_patterns[index];
+}
+
+std::size_t PatternSet::getMaxLength() const noexcept
+{
+    return m_maxLength;
+}
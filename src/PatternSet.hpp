@@ -0,0 +1,64 @@
+#ifndef PATTERNSET_H
+#define PATTERNSET_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "ByteSearch.hpp"
+
+// A set of byte strings which can all be searched in a single pass over the data
+// (Aho-Corasick automaton). The data can be fed block by block: the state returned
+// by 'feed' has to be given back with the next contiguous block.
+class PatternSet
+{
+    public:
+        using State = std::uint32_t;
+
+        PatternSet(const std::vector<std::string> &patterns);
+
+        std::size_t size() const noexcept;
+        const std::string& getPattern(std::size_t index) const noexcept;
+        std::size_t getMaxLength() const noexcept;
+
+        // runs the automaton over [first, last) from 'state' and returns the final state
+        // 'onMatch(end, index)' is called for every occurrence of the pattern 'index',
+        // 'end' being a pointer past its last byte
+        template<typename Callback> State feed(State state, const char *first, const char *last, Callback onMatch) const
+        {
+            while(first != last)
+            {
+                // in the initial state, the bytes which can't start a pattern are skipped at once
+                if(state == 0)
+                {
+                    first = searchAnyByte(first, last, m_firstBytes.data(), m_firstBytes.size());
+                    if(first == last)
+                        break;
+                }
+
+                state = m_transitions[state * 0x100 + static_cast<unsigned char>(*first)];
+                ++first;
+
+                for(auto i = m_outputOffsets[state]; i < m_outputOffsets[state + 1]; ++i)
+                    onMatch(first, m_outputs[i]);
+            }
+
+            return state;
+        }
+
+    private:
+        std::vector<std::string> m_patterns;
+        std::size_t m_maxLength {0};
+
+        // bytes which start at least one pattern
+        std::string m_firstBytes;
+
+        // 256 transitions per state
+        std::vector<State> m_transitions;
+
+        // patterns recognized in each state: m_outputs[m_outputOffsets[state]...m_outputOffsets[state + 1]]
+        std::vector<std::size_t> m_outputOffsets;
+        std::vector<std::size_t> m_outputs;
+};
+
+#endif // PATTERNSET_H
@@ -0,0 +1,87 @@
+#include "PointerChain.hpp"
+
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    std::string trim(const std::string &str)
+    {
+        const auto first = str.find_first_not_of(" \t");
+        if(first == std::string::npos)
+            return "";
+
+        return str.substr(first, str.find_last_not_of(" \t") - first + 1);
+    }
+
+    std::int64_t parseOffset(const std::string &str)
+    {
+        auto offset = trim(str);
+        const bool negative = !offset.empty() && offset[0] == '-';
+        if(negative)
+            offset.erase(0, 1);
+
+        std::size_t end {0};
+        std::uint64_t value {0};
+
+        try
+        {
+            value = std::stoull(offset, &end, 16);
+        }
+        catch(const std::exception &)
+        {
+            end = 0;
+        }
+
+        if(offset.empty() || !std::isxdigit(static_cast<unsigned char>(offset[0])) || end != offset.size())
+            throw std::invalid_argument("Invalid pointer offset \"" + str + "\".");
+
+        return negative ? -static_cast<std::int64_t>(value) : static_cast<std::int64_t>(value);
+    }
+}
+
+PointerChain PointerChain::parse(const std::string &str)
+{
+    PointerChain chain;
+
+    auto first = str.find("->");
+    const auto base = str.substr(0, first);
+
+    // the module name may be quoted, and may contain '+'
+    const auto plus = base.rfind('+');
+    if(plus == std::string::npos)
+        throw std::invalid_argument("Invalid pointer chain \"" + str + "\" (missing module).");
+
+    chain.moduleName = trim(base.substr(0, plus));
+    if(chain.moduleName.size() >= 2 && chain.moduleName.front() == '"' && chain.moduleName.back() == '"')
+        chain.moduleName = chain.moduleName.substr(1, chain.moduleName.size() - 2);
+
+    if(chain.moduleName.empty())
+        throw std::invalid_argument("Invalid pointer chain \"" + str + "\" (missing module).");
+
+    chain.offsets.push_back(parseOffset(base.substr(plus + 1)));
+
+    while(first != std::string::npos)
+    {
+        const auto next = str.find("->", first + 2);
+        chain.offsets.push_back(parseOffset(str.substr(first + 2, next - first - 2)));
+        first = next;
+    }
+
+    return chain;
+}
+
+std::string PointerChain::toString() const
+{
+    std::ostringstream os;
+    os << '"' << moduleName << '"';
+
+    for(std::size_t i = 0; i < offsets.size(); ++i)
+    {
+        os << (i == 0 ? "+" : " -> ") << (offsets[i] < 0 ? "-" : "") << "0x" << std::hex << std::uppercase
+            << (offsets[i] < 0 ? -static_cast<std::uint64_t>(offsets[i]) : static_cast<std::uint64_t>(offsets[i]));
+    }
+
+    return os.str();
+}
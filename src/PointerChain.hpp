@@ -0,0 +1,25 @@
+#ifndef POINTERCHAIN_H
+#define POINTERCHAIN_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A path to an address which doesn't depend on where the memory is allocated:
+// the address of the module plus the first offset is read as a pointer, which
+// plus the second offset is read as a pointer, and so on. The last offset is
+// added to the last pointer.
+// It is written the same way as Cheat Engine does:
+// "Rayman Legends.exe"+0x00A1B2C4 -> 0x10 -> 0x34
+struct PointerChain
+{
+    std::string moduleName;
+    std::vector<std::int64_t> offsets;
+
+    // throws std::invalid_argument if the chain is malformed
+    static PointerChain parse(const std::string &str);
+
+    std::string toString() const;
+};
+
+#endif // POINTERCHAIN_H
@@ -1,14 +1,17 @@
 #include "Process.hpp"
 
+#include <atomic>
+#include <iterator>
+
+#include "Hash.hpp"
+#include "ProcessRegistry.hpp"
+#include "Snapshot.hpp"
+
 using std::cout;
 using std::endl;
 using std::flush;
 
-std::string wstrToStr(const std::wstring &ws)
-{
-    std::string str(ws.begin(), ws.end());
-    return str;
-}
+const Address Process::npos;
 
 Process::Process()
 {
@@ -28,94 +31,257 @@ void Process::open(const std::string &programFilename)
 
     cout << "Opening process " << processName << "... " << endl;
 
-    PROCESSENTRY32 entry;
-    entry.dwSize = sizeof(PROCESSENTRY32);
+    m_backend = ProcessRegistry::getInstance().open(programFilename);
+
+    if(m_backend == nullptr)
+    {
+        cout << "Failure!" << endl;
+        throw std::runtime_error("Failed to open process \"" + processName + "\"\nfrom \"" + programFilename + "\".");
+    }
+    else
+        cout << "Success! (Process ID: " << std::hex << std::showbase << m_backend->getProcessId() << ")" << endl;
+
+    // the previous scan is kept if the same launch of the game is opened again
+    if(m_scanCache.processId != m_backend->getProcessId() || m_scanCache.startTime != m_backend->getStartTime())
+        clearScanCache();
+}
+
+void Process::openSnapshot(const std::string &filename)
+{
+    cout << "Opening snapshot " << filename << "... " << endl;
+
+    m_backend = ::openSnapshot(filename);
+    clearScanCache();
+
+    cout << "Success! (Process ID: " << std::hex << std::showbase << m_backend->getProcessId() << ")" << endl;
+}
+
+void Process::open(std::shared_ptr<ProcessBackend> backend)
+{
+    if(backend == nullptr)
+        throw std::invalid_argument("No process to open.");
+
+    cout << "Opening process " << backend->getModuleName() << "... " << endl;
+
+    // the previous scan is kept if the same process is opened again
+    if(backend != m_backend)
+        clearScanCache();
+
+    m_backend = std::move(backend);
+
+    cout << "Success! (Process ID: " << std::hex << std::showbase << m_backend->getProcessId() << ")" << endl;
+}
+
+void Process::saveSnapshot(const std::string &filename)
+{
+    if(m_backend == nullptr)
+        throw std::runtime_error("No process is open.");
+
+    cout << "Saving snapshot " << filename << "... " << flush;
+
+    ::saveSnapshot(*m_backend, filename);
+
+    cout << "Done!" << endl;
+}
+
+void Process::setScanBlockSize(std::size_t size) noexcept
+{
+    // the blocks stay aligned on pages, for the incremental scans
+    const auto pageSize = ScanCache::pageSize;
+    m_scanBlockSize = std::max((size + pageSize - 1) / pageSize * pageSize, pageSize);
+}
+
+std::size_t Process::getScanBlockSize() const noexcept
+{
+    return m_scanBlockSize;
+}
+
+void Process::setScanThreadCount(unsigned count) noexcept
+{
+    m_scanPool = ScanPool(count);
+}
+
+unsigned Process::getScanThreadCount() const noexcept
+{
+    return m_scanPool.getThreadCount();
+}
+
+ScanControl& Process::getScanControl() noexcept
+{
+    return m_scanControl;
+}
+
+ScanStats& Process::getStats() noexcept
+{
+    return m_stats;
+}
+
+unsigned Process::getProcessId() const noexcept
+{
+    return m_backend != nullptr ? m_backend->getProcessId() : 0;
+}
+
+std::uint64_t Process::getStartTime() noexcept
+{
+    return m_backend != nullptr ? m_backend->getStartTime() : 0;
+}
 
-    auto snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+std::vector<Module> Process::getModules() noexcept
+{
+    if(m_backend == nullptr)
+        return std::vector<Module>();
+
+    auto modules = m_backend->getModules();
+    for(auto &module : modules)
+        module.fingerprint = getFingerprint(module);
 
-    m_processHandle = nullptr;
+    return modules;
+}
+
+std::uint64_t Process::getModuleFingerprint() noexcept
+{
+    if(m_backend == nullptr)
+        return 0;
+
+    const auto modules = m_backend->getModules();
+    return modules.empty() ? 0 : getFingerprint(modules.front());
+}
+
+std::uint64_t Process::getFingerprint(const Module &module) noexcept
+{
+    // the PE header holds the link timestamp and the checksum of the module
+    std::array<char, 0x1000> header;
+    const auto size = std::min(header.size(), module.size);
 
-    if(Process32First(snapshot, &entry))
+    if(size == 0 || !readInto(module.base, header.data(), size))
+        return 0;
+
+    return hashBytes(header.data(), size);
+}
+
+Address Process::resolvePointerChain(const PointerChain &chain, std::size_t pointerSize) noexcept
+{
+    auto strToUpper = [](const std::string &str)
     {
-        while(Process32Next(snapshot, &entry))
-            if(processName == wstrToStr(entry.szExeFile))
-            {
-                m_processHandle = OpenProcess(PROCESS_ALL_ACCESS, false, entry.th32ProcessID);
+        std::string newStr;
+        std::transform(str.begin(), str.end(), std::back_inserter(newStr), ::toupper);
+        return newStr;
+    };
 
-                std::wstring moduleFilename(MAX_PATH, 0);
-                auto strSize = GetModuleFileNameEx(m_processHandle, nullptr, &moduleFilename[0], MAX_PATH);
-                moduleFilename.erase(strSize);
+    if(m_backend == nullptr)
+        return npos;
 
-                auto strToUpper = [](const std::string &str)
-                {
-                    std::string newStr;
-                    std::transform(str.begin(), str.end(), std::back_inserter(newStr), ::toupper);
-                    return newStr;
-                };
+    const auto modules = m_backend->getModules();
+    auto module = std::find_if(modules.begin(), modules.end(), [&](const Module &m)
+    {
+        return strToUpper(m.name) == strToUpper(chain.moduleName);
+    });
 
-                if(strToUpper(wstrToStr(moduleFilename)) != strToUpper(programFilename))
-                    m_processHandle = nullptr;
+    if(module == modules.end() || chain.offsets.empty() || pointerSize > sizeof(Address))
+        return npos;
 
-                else break;
-            }
-    }
+    auto address = module->base + static_cast<Address>(chain.offsets.front());
 
-    if(m_processHandle == nullptr)
+    // the pointers are little endian, whatever the endianness of the values
+    for(auto offset = chain.offsets.begin() + 1; offset != chain.offsets.end(); ++offset)
     {
-        cout << "Failure!" << endl;
-        throw std::runtime_error("Failed to open process \"" + processName + "\"\nfrom \"" + programFilename + "\".");
+        Address pointer {0};
+        if(!readInto(address, reinterpret_cast<char*>(&pointer), pointerSize) || pointer == 0)
+            return npos;
+
+        address = pointer + static_cast<Address>(*offset);
     }
-    else
-        cout << "Success! (Process ID: " << std::hex << std::showbase << entry.th32ProcessID << ")" << endl;
-}
 
-void Process::setEndianness(Endianness endianness) noexcept
-{
-    m_endianness = endianness;
+    return address;
 }
 
 bool Process::validArea(Address address)
 {
     char byte;
-    return ReadProcessMemory(m_processHandle, reinterpret_cast<void*>(address),
-        &byte, sizeof(byte), nullptr);
+    return readInto(address, &byte, sizeof(byte));
+}
+
+bool Process::readInto(Address address, char *buffer, std::size_t length) noexcept
+{
+    m_stats.add(ScanStats::BackendCalls);
+
+    if(m_backend == nullptr || !m_backend->read(address, buffer, length))
+    {
+        m_stats.add(ScanStats::FailedReads);
+        return false;
+    }
+
+    m_stats.add(ScanStats::BytesRead, length);
+    return true;
 }
 
 std::vector<char> Process::readDataNoExcept(Address address, std::size_t length) noexcept
 {
     std::vector<char> buffer(length);
-    if(!ReadProcessMemory(m_processHandle, reinterpret_cast<void*>(address),
-        buffer.data(), buffer.size(), nullptr))
-            return std::vector<char>();
+    if(!readInto(address, buffer.data(), buffer.size()))
+        return std::vector<char>();
 
     return buffer;
 }
 
-std::vector<char> Process::readData(Address address, std::size_t length)
+bool Process::readBatch(ReadRequest *requests, std::size_t count) noexcept
 {
-    auto buffer = readDataNoExcept(address, length);
-    if(length != buffer.size())
+    if(m_backend == nullptr)
     {
-        cout << "Failure!" << endl;
+        for(std::size_t i = 0; i < count; ++i)
+            requests[i].success = false;
 
-        std::ostringstream os;
-        os << "Failed to read memory from process \"" << getCurrentModuleName() << "\" (at " << std::showbase << std::hex << address << ").";
-
-        throw std::runtime_error(os.str());
+        m_stats.add(ScanStats::FailedReads, count);
+        return count == 0;
     }
 
+    m_stats.add(ScanStats::BackendCalls);
+    const auto successCount = m_backend->readBatch(requests, count);
+
+    for(std::size_t i = 0; i < count; ++i)
+        if(requests[i].success)
+            m_stats.add(ScanStats::BytesRead, requests[i].length);
+
+    m_stats.add(ScanStats::FailedReads, count - successCount);
+    return successCount == count;
+}
+
+void Process::throwReadError(Address address)
+{
+    cout << "Failure!" << endl;
+
+    std::ostringstream os;
+    os << "Failed to read memory from process \"" << getCurrentModuleName() << "\" (at " << std::showbase << std::hex << address << ").";
+
+    throw std::runtime_error(os.str());
+}
+
+std::vector<char> Process::readData(Address address, std::size_t length)
+{
+    std::vector<char> buffer(length);
+    if(!readInto(address, buffer.data(), buffer.size()))
+        throwReadError(address);
+
     return buffer;
 }
 
 std::string Process::readString(Address address)
 {
-    std::string str = readData(address, MAX_PATH).data();
-    return str;
+    std::array<char, maxStringLength> data;
+    if(!readInto(address, data.data(), data.size()))
+        throwReadError(address);
+
+    return std::string(data.begin(), std::find(data.begin(), data.end(), '\0'));
 }
 
 void Process::writeData(Address address, std::vector<char> data)
 {
-    if(!WriteProcessMemory(m_processHandle, reinterpret_cast<void*>(address), data.data(), data.size(), nullptr))
+    if(m_backend == nullptr)
+        throw std::runtime_error("No process is open.");
+
+    m_stats.add(ScanStats::BackendCalls);
+
+    if(!m_backend->write(address, data.data(), data.size()))
     {
         cout << "Failure!" << endl;
 
@@ -126,71 +292,351 @@ void Process::writeData(Address address, std::vector<char> data)
     }
 }
 
-Address Process::findString(const std::string &str, Address address, bool backwards) noexcept
+bool Process::writeBatch(WriteRequest *requests, std::size_t count) noexcept
 {
-    const std::size_t chunkLength {0x1000};
-    const auto startAddress = address;
-    address = startAddress - (backwards ? chunkLength : 0);
+    if(m_backend == nullptr)
+    {
+        for(std::size_t i = 0; i < count; ++i)
+            requests[i].success = false;
+
+        return count == 0;
+    }
 
-    for(;backwards ? address > 0 : npos - address >= chunkLength;
-        address += (backwards ? -1 : 1) * chunkLength - address % chunkLength)
+    m_stats.add(ScanStats::BackendCalls);
+    return m_backend->writeBatch(requests, count) == count;
+}
+
+std::vector<MemoryRegion> Process::getRegions() noexcept
+{
+    if(m_backend == nullptr)
+        return std::vector<MemoryRegion>();
+
+    return m_backend->getRegions();
+}
+
+std::vector<Process::ScanBlock> Process::getScanBlocks(Address first, Address last, std::size_t overlap) noexcept
+{
+    auto regions = getRegions();
+    const auto regionCount = regions.size();
+
+    regions.erase(std::remove_if(regions.begin(), regions.end(),
+        [first, last](const MemoryRegion &region)
+        {
+            return region.type == RegionType::Image || region.end() <= first || region.base >= last;
+        }), regions.end());
+
+    m_stats.add(ScanStats::SkippedRegions, regionCount - regions.size());
+
+    return getScanBlocks(regions, first, last, overlap);
+}
+
+std::vector<Process::ScanBlock> Process::getScanBlocks(const std::vector<MemoryRegion> &regions,
+    Address first, Address last, std::size_t overlap) noexcept
+{
+    std::vector<ScanBlock> blocks;
+
+    for(auto region = regions.begin(); region != regions.end();)
     {
-        if(!validArea(address))
-            continue;
+        // contiguous regions are merged so that a pattern can straddle them
+        const auto spanFirst = std::max(region->base, first);
+        auto spanLast = region->end();
+        while(++region != regions.end() && region->base == spanLast)
+            spanLast = region->end();
+
+        spanLast = std::min(spanLast, last);
+
+        for(auto address = spanFirst; address < spanLast; address += m_scanBlockSize)
+        {
+            const auto length = std::min(m_scanBlockSize, spanLast - address);
+            blocks.push_back({address, length, std::min(overlap, spanLast - address - length)});
+        }
+    }
 
-        auto buffer = readDataNoExcept(address, chunkLength);
-        if(buffer.empty())
-            continue;
+    return blocks;
+}
+
+std::size_t Process::getTotalSize(const std::vector<ScanBlock> &blocks) noexcept
+{
+    std::size_t totalSize {0};
+    for(const auto &block : blocks)
+        totalSize += block.length;
 
-        auto it = std::search(buffer.begin(), buffer.end(), str.begin(), str.end());
-        if(it != buffer.end())
-            return address + std::distance(buffer.begin(), it);
+    return totalSize;
+}
+
+void Process::runScan(std::size_t blockCount, const std::function<void(std::size_t)> &scanBlock)
+{
+    // the scan is ended before its error is reported, so that the next one can begin
+    try
+    {
+        m_scanPool.run(blockCount, scanBlock);
     }
+    catch(...)
+    {
+        m_scanControl.endScan();
+        throw;
+    }
+}
+
+Address Process::findFirst(const std::vector<ScanBlock> &blocks,
+    const std::function<const char*(const char*, const char*)> &search)
+{
+    // the first block holding the pattern wins, the blocks located after it are skipped
+    std::vector<Address> results(blocks.size(), npos);
+    std::atomic<std::size_t> firstResult {blocks.size()};
+
+    m_scanControl.beginScan(getTotalSize(blocks), blocks.size());
+
+    runScan(blocks.size(), [&](std::size_t index)
+    {
+        if(index > firstResult || m_scanControl.isStopped())
+            return;
+
+        const auto &block = blocks[index];
+
+        thread_local std::vector<char> buffer;
+        buffer.resize(block.length + block.overlap);
+
+        bool found {false};
+        if(readInto(block.address, buffer.data(), buffer.size()))
+        {
+            const auto bufferEnd = buffer.data() + buffer.size();
+            auto it = search(buffer.data(), bufferEnd);
+            if(it != bufferEnd)
+            {
+                results[index] = block.address + (it - buffer.data());
+                found = true;
+            }
+        }
+
+        m_stats.add(ScanStats::ScannedBytes, block.length);
+        m_scanControl.addProgress(block.length, found);
+        if(!found)
+            return;
+
+        m_stats.add(ScanStats::CandidateHits);
+
+        auto current = firstResult.load();
+        while(index < current && !firstResult.compare_exchange_weak(current, index));
+    });
+
+    m_scanControl.endScan();
+
+    // a stopped scan may have skipped blocks located before the result
+    if(m_scanControl.isStopped())
+        return npos;
 
-    cout << endl << "Can't find string \"" << str << "\" in process memory! (From address " << std::showbase << std::hex << startAddress << ")" << endl;
-    return npos;
+    return firstResult < blocks.size() ? results[firstResult] : npos;
 }
 
-bool Process::searchRegex(const std::regex &reg, Address address, std::size_t length) noexcept
+Address Process::findString(const std::string &str, Address address, bool backwards)
 {
-    auto buffer = readDataNoExcept(address, length);
+    auto blocks = getScanBlocks(backwards ? 0 : address, backwards ? address : npos,
+        str.empty() ? 0 : str.size() - 1);
+
+    if(backwards)
+        std::reverse(blocks.begin(), blocks.end());
+
+    const auto result = findFirst(blocks, [&str, backwards](const char *first, const char *last)
+    {
+        return backwards
+            ? searchBytesBackwards(first, last, str.data(), str.size())
+            : searchBytes(first, last, str.data(), str.size());
+    });
 
-    return std::regex_search(buffer.begin(), buffer.end(), reg);
+    if(result == npos && !m_scanControl.isStopped())
+        cout << endl << "Can't find string \"" << str << "\" in process memory! (From address " << std::showbase << std::hex << address << ")" << endl;
+
+    return result;
 }
 
-std::string Process::getProcessLocation(const std::string &processName) noexcept
+std::vector<StringMatch> Process::findStrings(const PatternSet &patterns, Address first, Address last)
 {
-    PROCESSENTRY32 entry;
-    entry.dwSize = sizeof(PROCESSENTRY32);
+    return findStrings(patterns, getScanBlocks(first, last, patterns.getMaxLength() - 1));
+}
+
+std::vector<StringMatch> Process::findStrings(const PatternSet &patterns, const std::vector<MemoryRegion> &regions)
+{
+    return findStrings(patterns, getScanBlocks(regions, 0, npos, patterns.getMaxLength() - 1));
+}
+
+std::vector<StringMatch> Process::findStrings(const PatternSet &patterns, const std::vector<ScanBlock> &blocks)
+{
+    const auto pageSize = ScanCache::pageSize;
+    const auto overlap = patterns.getMaxLength() - 1;
+
+    // the previous scan is only read while the blocks are scanned
+    const bool incremental = m_scanCache.isValidFor(patterns);
+    const auto &oldPages = m_scanCache.pages;
+    const auto &oldMatches = m_scanCache.matches;
 
-    auto snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    std::vector<std::vector<ScanCache::Page>> blockPages(blocks.size());
+    std::vector<std::vector<StringMatch>> blockMatches(blocks.size());
+    std::atomic<std::size_t> scannedSize {0};
 
-    std::wstring processLocation {};
-    if(Process32First(snapshot, &entry))
+    auto scanBlock = [&](std::size_t index)
     {
-        while(Process32Next(snapshot, &entry))
-            if(processName == wstrToStr(entry.szExeFile))
+        const auto &block = blocks[index];
+        auto &pages = blockPages[index];
+        auto &matches = blockMatches[index];
+
+        thread_local std::vector<char> buffer;
+        buffer.resize(block.length + block.overlap);
+        if(!readInto(block.address, buffer.data(), buffer.size()))
+            return;
+
+        // searches the matches which start in [from, to)
+        // the matches which start in the overlap belong to the next block
+        auto search = [&](std::size_t from, std::size_t to)
+        {
+            const auto end = std::min(to + overlap, buffer.size());
+            patterns.feed(0, buffer.data() + from, buffer.data() + end,
+                [&](const char *matchEnd, std::size_t pattern)
+                {
+                    const auto offset = static_cast<std::size_t>(matchEnd - buffer.data()) - patterns.getPattern(pattern).size();
+                    if(offset < to)
+                        matches.push_back({block.address + offset, pattern});
+                });
+
+            scannedSize += to - from;
+        };
+
+        // only the blocks aligned on pages can be compared with the previous scan
+        if(block.address % pageSize != 0)
+        {
+            search(0, block.length);
+            return;
+        }
+
+        const auto pageCount = (block.length + pageSize - 1) / pageSize;
+        std::vector<bool> changed(pageCount, true);
+
+        auto oldPage = std::lower_bound(oldPages.begin(), oldPages.end(), block.address,
+            [](const ScanCache::Page &page, Address address){ return page.address < address; });
+
+        for(std::size_t i = 0; i < pageCount; ++i)
+        {
+            const auto offset = i * pageSize;
+            const ScanCache::Page page {block.address + offset,
+                hashBytes(buffer.data() + offset, std::min(pageSize, block.length - offset))};
+
+            while(incremental && oldPage != oldPages.end() && oldPage->address < page.address)
+                ++oldPage;
+
+            changed[i] = !incremental || oldPage == oldPages.end()
+                || oldPage->address != page.address || oldPage->hash != page.hash;
+
+            pages.push_back(page);
+        }
+
+        // a page is searched again if it changed or if the next one did,
+        // the last page of the block being followed by the next block
+        for(std::size_t i = 0; i < pageCount;)
+        {
+            const auto offset = i * pageSize;
+            const bool dirty = changed[i] || i + 1 == pageCount || changed[i + 1];
+
+            if(!dirty)
             {
-                auto handle = OpenProcess(PROCESS_ALL_ACCESS, false, entry.th32ProcessID);
+                m_stats.add(ScanStats::SkippedPages);
 
-                processLocation.assign(MAX_PATH, 0);
-                GetModuleFileNameEx(handle, nullptr, &processLocation[0], MAX_PATH);
+                const auto pageAddress = block.address + offset;
+                auto match = std::lower_bound(oldMatches.begin(), oldMatches.end(), pageAddress,
+                    [](const StringMatch &m, Address address){ return m.address < address; });
 
-                auto index = processLocation.find_last_of('\\');
-                processLocation.erase(index + 1);
+                for(; match != oldMatches.end() && match->address < pageAddress + pageSize; ++match)
+                    matches.push_back(*match);
 
-                break;
+                ++i;
+                continue;
             }
-    }
 
-    return wstrToStr(processLocation);
+            auto j = i + 1;
+            while(j < pageCount && (changed[j] || j + 1 == pageCount || changed[j + 1]))
+                ++j;
+
+            search(offset, std::min(j * pageSize, block.length));
+            i = j;
+        }
+    };
+
+    const auto totalSize = getTotalSize(blocks);
+    m_scanControl.beginScan(totalSize, blocks.size());
+
+    runScan(blocks.size(), [&](std::size_t index)
+    {
+        if(m_scanControl.isStopped())
+            return;
+
+        scanBlock(index);
+        m_scanControl.addProgress(blocks[index].length, blockMatches[index].size());
+    });
+
+    m_scanControl.endScan();
+
+    std::vector<StringMatch> matches;
+    for(const auto &m : blockMatches)
+        matches.insert(matches.end(), m.begin(), m.end());
+
+    m_stats.add(ScanStats::ScannedBytes, scannedSize);
+    m_stats.add(ScanStats::CandidateHits, matches.size());
+
+    std::stable_sort(matches.begin(), matches.end(),
+        [](const StringMatch &a, const StringMatch &b){ return a.address < b.address; });
+
+    // the cache only holds complete scans of an open process
+    if(m_scanControl.isStopped() || m_backend == nullptr)
+        return matches;
+
+    if(incremental)
+        cout << "Searched " << std::dec << scannedSize / 1024 << " KiB out of " << totalSize / 1024 << " KiB (incremental scan)." << endl;
+
+    // the scan is kept for the next call
+    ScanCache cache;
+    cache.processId = m_backend->getProcessId();
+    cache.startTime = m_backend->getStartTime();
+
+    for(std::size_t i = 0; i < patterns.size(); ++i)
+        cache.patterns.push_back(patterns.getPattern(i));
+
+    for(const auto &pages : blockPages)
+        cache.pages.insert(cache.pages.end(), pages.begin(), pages.end());
+
+    cache.matches = matches;
+    m_scanCache = std::move(cache);
+
+    return matches;
 }
 
-std::string Process::getCurrentModuleName() noexcept
+void Process::clearScanCache() noexcept
+{
+    m_scanCache = ScanCache();
+}
+
+bool Process::searchSignature(const Signature &signature, Address address, std::size_t length) noexcept
+{
+    auto buffer = readDataNoExcept(address, length);
+    const auto bufferEnd = buffer.data() + buffer.size();
+
+    return signature.search(buffer.data(), bufferEnd) != bufferEnd;
+}
+
+Address Process::findSignature(const Signature &signature, Address address)
+{
+    const auto blocks = getScanBlocks(address, npos, signature.size() - 1);
+
+    return findFirst(blocks, [&signature](const char *first, const char *last)
+    {
+        return signature.search(first, last);
+    });
+}
+
+std::string Process::getProcessLocation(const std::string &processName) noexcept
 {
-    std::wstring moduleName(MAX_PATH, 0);
-    auto strSize = GetModuleBaseName(m_processHandle, nullptr, &moduleName[0], MAX_PATH);
-    moduleName.erase(strSize);
+    return ProcessRegistry::getInstance().getLocation(processName);
+}
 
-    return wstrToStr(moduleName);
+std::string Process::getCurrentModuleName() noexcept
+{
+    return m_backend != nullptr ? m_backend->getModuleName() : std::string();
 }
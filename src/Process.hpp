@@ -3,20 +3,36 @@
 
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 #include <algorithm>
 #include <stdexcept>
 #include <array>
-#include <regex>
 #include <vector>
+#include <limits>
+#include <memory>
 #include <cassert>
-
-#include <windows.h>
-#include <tlhelp32.h>
-#include <psapi.h>
-
-using Address = std::size_t;
-
-enum class Endianness { Big, Little };
+#include <type_traits>
+
+#include "ByteOrder.hpp"
+#include "ByteSearch.hpp"
+#include "PatternSet.hpp"
+#include "ScanCache.hpp"
+#include "ScanControl.hpp"
+#include "ScanStats.hpp"
+#include "ScanPool.hpp"
+#include "Signature.hpp"
+#include "PointerChain.hpp"
+#include "ProcessBackend.hpp"
+
+// a request which reads a value in place, its endianness is converted afterwards
+template<typename T> ReadRequest makeReadRequest(Address address, T &value) noexcept
+{
+    ReadRequest request;
+    request.address = address;
+    request.buffer = reinterpret_cast<char*>(&value);
+    request.length = sizeof(T);
+    return request;
+}
 
 class Process
 {
@@ -24,12 +40,75 @@ class Process
         Process();
         Process(const std::string &programFilename);
 
+        // opens the running process whose main module is 'programFilename'
+        // the process opened before is reused while it is running
         void open(const std::string &programFilename);
-        void setEndianness(Endianness endianness) noexcept;
+
+        // opens a memory snapshot saved by 'saveSnapshot' instead of a running process
+        void openSnapshot(const std::string &filename);
+
+        // uses 'backend', one of the processes returned by 'ProcessRegistry::openAll' or a generated
+        // memory image for instance
+        // the previous scan is kept if 'backend' is already used
+        void open(std::shared_ptr<ProcessBackend> backend);
+
+        // saves the readable regions of the process memory into 'filename'
+        void saveSnapshot(const std::string &filename);
+
+        // sets the amount of memory read at once when scanning the process memory
+        // it is rounded up to a multiple of the page size
+        void setScanBlockSize(std::size_t size) noexcept;
+        std::size_t getScanBlockSize() const noexcept;
+
+        // sets the number of threads which scan the process memory, 0 means one per hardware thread
+        void setScanThreadCount(unsigned count) noexcept;
+        unsigned getScanThreadCount() const noexcept;
+
+        // cancels the scans, limits them and reports their progress
+        // a stopped scan returns what it found so far
+        ScanControl& getScanControl() noexcept;
+
+        // counts the reads and the scans, until it is reset
+        ScanStats& getStats() noexcept;
+
+        // until a process is opened, the reads and the writes fail, the functions below
+        // return empty values and the scans find nothing
 
         // returns true if the current area is readable
         bool validArea(Address address);
 
+        // returns every committed and readable region of the process memory, sorted by address
+        // guard pages and inaccessible areas are skipped
+        std::vector<MemoryRegion> getRegions() noexcept;
+
+        unsigned getProcessId() const noexcept;
+
+        // returns a value which identifies the process launch, or 0 if it is unknown
+        std::uint64_t getStartTime() noexcept;
+
+        // returns the loaded modules, the main module first
+        std::vector<Module> getModules() noexcept;
+
+        // returns the fingerprint of the main module, or 0 if it can't be read
+        // it changes when the game executable is updated
+        std::uint64_t getModuleFingerprint() noexcept;
+
+        // follows a pointer chain from the base of its module, the pointers being
+        // 'pointerSize' bytes long (the game is a 32-bit process)
+        // if a module or a pointer can't be read, the value 'npos' is returned
+        Address resolvePointerChain(const PointerChain &chain, std::size_t pointerSize = 4) noexcept;
+
+        // reads 'length' bytes into 'buffer', returns false on failure
+        bool readInto(Address address, char *buffer, std::size_t length) noexcept;
+
+        // reads every request, returns true if all of them succeeded
+        // the requests are gathered into as few system calls as possible
+        bool readBatch(ReadRequest *requests, std::size_t count) noexcept;
+        template<std::size_t N> bool readBatch(std::array<ReadRequest, N> &requests) noexcept
+        {
+            return readBatch(requests.data(), N);
+        }
+
         std::vector<char> readData(Address address, std::size_t length);
 
         // reads a null terminated string
@@ -37,13 +116,24 @@ class Process
 
         void writeData(Address address, std::vector<char> data);
 
+        // writes every request, returns true if all of them succeeded
+        // the requests are gathered into as few system calls as possible
+        bool writeBatch(WriteRequest *requests, std::size_t count) noexcept;
+
         template<typename T> T readValue(Address address)
         {
-            assert(std::is_arithmetic<T>::value);
-            auto data = readData(address, sizeof(T));
-            if(m_endianness == Endianness::Big)
-                std::reverse(data.begin(), data.end());
-            return *reinterpret_cast<T*>(data.data());
+            T value;
+            if(!readValue(address, value))
+                throwReadError(address);
+
+            return value;
+        }
+
+        // returns false on failure instead of throwing
+        // the values are read and written in the endianness of the computer, see 'ChallengeLayout'
+        template<typename T> bool readValue(Address address, T &value) noexcept
+        {
+            return readInto(address, reinterpret_cast<char*>(&value), sizeof(T));
         }
 
         template<typename T> void writeValue(Address address, T value)
@@ -51,20 +141,38 @@ class Process
             assert(std::is_arithmetic<T>::value);
             std::vector<char> data(sizeof(T));
             std::copy_n(reinterpret_cast<char*>(&value), data.size(), data.data());
-            if(m_endianness == Endianness::Big)
-                std::reverse(data.begin(), data.end());
             writeData(address, data);
         }
 
         // tries to find a string in the process memory
         // starts at 'address'
         // set 'backwards' to true if the string is located before 'address'
+        // only the readable regions which are not mapped images are scanned
+        // the blocks are scanned in parallel but the closest occurrence is always returned
         // if the string is not found, the value 'npos' is returned
-        Address findString(const std::string &str, Address address = 0, bool backwards = false) noexcept;
+        // throws if the scanning threads can't be started or run out of memory, like the other scans
+        Address findString(const std::string &str, Address address = 0, bool backwards = false);
 
-        // tries to find a regular expression in a chunk of size 'lenght' in the process memory
-        // returns true if the regex has been found
-        bool searchRegex(const std::regex &str, Address address = 0, std::size_t length = npos) noexcept;
+        // finds every occurrence of the given patterns located between 'first' and 'last'
+        // the process memory is traversed only once, the same way as 'findString' does
+        // the matches are sorted by address
+        // if the previous call searched the same patterns, the pages it read which didn't change since
+        // are not searched again, whatever the range or the regions of both calls
+        std::vector<StringMatch> findStrings(const PatternSet &patterns, Address first = 0, Address last = npos);
+
+        // same as above, but only 'regions' are searched, they must be sorted by address
+        std::vector<StringMatch> findStrings(const PatternSet &patterns, const std::vector<MemoryRegion> &regions);
+
+        // forgets the previous 'findStrings' call, so that the next one searches every page
+        void clearScanCache() noexcept;
+
+        // returns true if the signature is found in the chunk of size 'length' located at 'address'
+        bool searchSignature(const Signature &signature, Address address, std::size_t length) noexcept;
+
+        // tries to find a signature in the process memory, starting at 'address'
+        // the memory is scanned the same way as 'findString' does
+        // if the signature is not found, the value 'npos' is returned
+        Address findSignature(const Signature &signature, Address address = 0);
 
         // returns the location of the specified process name
         static std::string getProcessLocation(const std::string &processName) noexcept;
@@ -74,11 +182,58 @@ class Process
         // a return value which indicates a failure
         static const Address npos { std::numeric_limits<std::size_t>::max() };
 
+        static const std::size_t defaultScanBlockSize { 0x40'0000 };
+
+        // the maximal length of the strings read by 'readString'
+        static const std::size_t maxStringLength { 260 };
+
     private:
+        // a part of the process memory which is read and scanned at once
+        // 'overlap' bytes following the block are read too, so that the patterns
+        // which start at the end of the block can be found
+        struct ScanBlock
+        {
+            Address address;
+            std::size_t length;
+            std::size_t overlap;
+        };
+
+        // splits the readable regions (excepted images) located between 'first' and 'last' into blocks
+        std::vector<ScanBlock> getScanBlocks(Address first, Address last, std::size_t overlap) noexcept;
+
+        // splits the parts of 'regions' located between 'first' and 'last' into blocks
+        // the contiguous regions are merged, so that a pattern can straddle them
+        std::vector<ScanBlock> getScanBlocks(const std::vector<MemoryRegion> &regions,
+            Address first, Address last, std::size_t overlap) noexcept;
+
+        // returns the amount of memory scanned over 'blocks', without their overlaps
+        static std::size_t getTotalSize(const std::vector<ScanBlock> &blocks) noexcept;
+
+        // finds every occurrence of the patterns in the blocks, using and updating 'm_scanCache'
+        std::vector<StringMatch> findStrings(const PatternSet &patterns, const std::vector<ScanBlock> &blocks);
+
+        // calls 'scanBlock' for each block index on the scan pool, the scan is ended if it throws
+        void runScan(std::size_t blockCount, const std::function<void(std::size_t)> &scanBlock);
+
+        // scans the blocks in parallel with 'search', which returns a pointer to the pattern it looks for
+        // or the end of the data it is given, and returns the address found in the first block holding it
+        Address findFirst(const std::vector<ScanBlock> &blocks,
+            const std::function<const char*(const char*, const char*)> &search);
+
+        // returns a hash of the header of the module, or 0 if it can't be read
+        std::uint64_t getFingerprint(const Module &module) noexcept;
+
         std::vector<char> readDataNoExcept(Address address, std::size_t length) noexcept;
 
-        HANDLE m_processHandle {nullptr};
-        Endianness m_endianness { Endianness::Little };
+        [[noreturn]] void throwReadError(Address address);
+
+        // shared with the other users of the same process, see 'ProcessRegistry'
+        std::shared_ptr<ProcessBackend> m_backend;
+        std::size_t m_scanBlockSize { defaultScanBlockSize };
+        ScanPool m_scanPool;
+        ScanCache m_scanCache;
+        ScanControl m_scanControl;
+        ScanStats m_stats;
 };
 
 #endif // PROCESS_H
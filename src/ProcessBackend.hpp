@@ -0,0 +1,136 @@
+#ifndef PROCESSBACKEND_H
+#define PROCESSBACKEND_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using Address = std::size_t;
+
+enum class RegionType { Private, Mapped, Image };
+
+// a committed and readable area of the process memory
+struct MemoryRegion
+{
+    Address base {0};
+    std::size_t size {0};
+    bool writable {false};
+    bool executable {false};
+    RegionType type {RegionType::Private};
+
+    Address end() const noexcept { return base + size; }
+};
+
+// an area to read with 'ProcessBackend::readBatch', into a buffer owned by the caller
+struct ReadRequest
+{
+    Address address {0};
+    char *buffer {nullptr};
+    std::size_t length {0};
+
+    // set by 'readBatch'
+    bool success {false};
+};
+
+// an area to write with 'ProcessBackend::writeBatch'
+struct WriteRequest
+{
+    Address address {0};
+    const char *buffer {nullptr};
+    std::size_t length {0};
+
+    // set by 'writeBatch'
+    bool success {false};
+};
+
+// an executable or a library loaded in the process memory
+struct Module
+{
+    std::string name;
+    Address base {0};
+    std::size_t size {0};
+
+    // hash of the module header, which identifies the build of the module
+    // it is filled by 'Process::getModules'
+    std::uint64_t fingerprint {0};
+};
+
+// a running process, as enumerated by 'findProcesses'
+struct ProcessInfo
+{
+    unsigned processId {0};
+
+    // path of the main module, as seen by the host
+    std::string filename;
+
+    // see 'ProcessBackend::getStartTime'
+    std::uint64_t startTime {0};
+};
+
+// Platform specific access to the memory of another process.
+// 'Process' implements everything else on top of these functions.
+class ProcessBackend
+{
+    public:
+        virtual ~ProcessBackend() = default;
+
+        // reads 'length' bytes into 'buffer', returns false on failure
+        virtual bool read(Address address, char *buffer, std::size_t length) noexcept = 0;
+
+        // reads every request, returns the number of requests which succeeded
+        // the backends may gather the requests into fewer system calls
+        virtual std::size_t readBatch(ReadRequest *requests, std::size_t count) noexcept
+        {
+            std::size_t successCount {0};
+            for(std::size_t i = 0; i < count; ++i)
+                successCount += requests[i].success = read(requests[i].address, requests[i].buffer, requests[i].length);
+
+            return successCount;
+        }
+
+        // writes 'length' bytes from 'buffer', returns false on failure
+        virtual bool write(Address address, const char *buffer, std::size_t length) noexcept = 0;
+
+        // writes every request, returns the number of requests which succeeded
+        // the backends may gather the requests into fewer system calls
+        virtual std::size_t writeBatch(WriteRequest *requests, std::size_t count) noexcept
+        {
+            std::size_t successCount {0};
+            for(std::size_t i = 0; i < count; ++i)
+                successCount += requests[i].success = write(requests[i].address, requests[i].buffer, requests[i].length);
+
+            return successCount;
+        }
+
+        // returns every committed and readable region of the process memory, sorted by address
+        // guard pages and inaccessible areas are skipped
+        virtual std::vector<MemoryRegion> getRegions() noexcept = 0;
+
+        virtual unsigned getProcessId() const noexcept = 0;
+
+        // returns the filename of the main module, without its folder
+        virtual std::string getModuleName() noexcept = 0;
+
+        // returns the loaded modules, the main module first
+        virtual std::vector<Module> getModules() noexcept = 0;
+
+        // returns a value which identifies the process launch, or 0 if it is unknown
+        // two processes which reuse the same ID have different start times
+        virtual std::uint64_t getStartTime() noexcept = 0;
+
+        // returns false once the process has exited
+        virtual bool isAlive() noexcept = 0;
+};
+
+// The following functions are implemented once per platform
+// (WindowsProcess.cpp, LinuxProcess.cpp).
+
+// returns the running processes whose main module is named 'processName'
+std::vector<ProcessInfo> findProcesses(const std::string &processName);
+
+// opens the given process, returns nullptr if it is not running anymore
+// (a process which reused its ID has another start time)
+std::unique_ptr<ProcessBackend> openProcessBackend(const ProcessInfo &process);
+
+#endif // PROCESSBACKEND_H
@@ -0,0 +1,144 @@
+#include "ProcessRegistry.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+    std::string strToUpper(const std::string &str)
+    {
+        std::string newStr;
+        std::transform(str.begin(), str.end(), std::back_inserter(newStr), ::toupper);
+        return newStr;
+    }
+
+    std::string getFilename(const std::string &path)
+    {
+        return path.substr(path.find_last_of("/\\") + 1);
+    }
+
+    bool isSameFile(const std::string &a, const std::string &b)
+    {
+        return strToUpper(a) == strToUpper(b);
+    }
+}
+
+ProcessRegistry& ProcessRegistry::getInstance()
+{
+    static ProcessRegistry registry;
+    return registry;
+}
+
+std::shared_ptr<ProcessBackend> ProcessRegistry::open(const std::string &programFilename)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // the process opened last time is kept while it is running
+    auto openProcess = std::find_if(m_openProcesses.begin(), m_openProcesses.end(),
+        [&programFilename](const OpenProcess &p){ return isSameFile(p.info.filename, programFilename); });
+
+    if(openProcess != m_openProcesses.end())
+    {
+        if(openProcess->backend->isAlive())
+            return openProcess->backend;
+
+        m_openProcesses.erase(openProcess);
+    }
+
+    auto tryOpen = [this, &programFilename](const std::vector<ProcessInfo> &processes)
+    {
+        for(const auto &process : processes)
+        {
+            if(!isSameFile(process.filename, programFilename))
+                continue;
+
+            std::shared_ptr<ProcessBackend> backend = openProcessBackend(process);
+            if(backend == nullptr)
+                continue;
+
+            m_openProcesses.push_back({process, backend});
+            return backend;
+        }
+
+        return std::shared_ptr<ProcessBackend>();
+    };
+
+    // the last enumeration is tried first, the processes are enumerated again if it is outdated
+    auto &processes = m_processes[getFilename(programFilename)];
+    if(!processes.empty())
+        if(auto backend = tryOpen(processes))
+            return backend;
+
+    processes = findProcesses(getFilename(programFilename));
+    return tryOpen(processes);
+}
+
+std::vector<std::shared_ptr<ProcessBackend>> ProcessRegistry::openAll(const std::string &programFilename)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // the processes which exited are forgotten
+    m_openProcesses.erase(std::remove_if(m_openProcesses.begin(), m_openProcesses.end(),
+        [](const OpenProcess &p){ return !p.backend->isAlive(); }), m_openProcesses.end());
+
+    auto processes = enumerate(getFilename(programFilename), true);
+    std::sort(processes.begin(), processes.end(),
+        [](const ProcessInfo &a, const ProcessInfo &b){ return a.processId < b.processId; });
+
+    std::vector<std::shared_ptr<ProcessBackend>> backends;
+    for(const auto &process : processes)
+    {
+        if(!isSameFile(process.filename, programFilename))
+            continue;
+
+        auto openProcess = std::find_if(m_openProcesses.begin(), m_openProcesses.end(),
+            [&process](const OpenProcess &p){ return p.info.processId == process.processId; });
+
+        if(openProcess != m_openProcesses.end())
+        {
+            backends.push_back(openProcess->backend);
+            continue;
+        }
+
+        std::shared_ptr<ProcessBackend> backend = openProcessBackend(process);
+        if(backend == nullptr)
+            continue;
+
+        m_openProcesses.push_back({process, backend});
+        backends.push_back(backend);
+    }
+
+    return backends;
+}
+
+std::vector<ProcessInfo> ProcessRegistry::getProcesses(const std::string &processName, bool refresh)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return enumerate(processName, refresh);
+}
+
+std::string ProcessRegistry::getLocation(const std::string &processName)
+{
+    const auto processes = getProcesses(processName);
+    if(processes.empty())
+        return "";
+
+    const auto &filename = processes.front().filename;
+    return filename.substr(0, filename.find_last_of("/\\") + 1);
+}
+
+void ProcessRegistry::clear() noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_processes.clear();
+    m_openProcesses.clear();
+}
+
+std::vector<ProcessInfo>& ProcessRegistry::enumerate(const std::string &processName, bool refresh)
+{
+    auto &processes = m_processes[processName];
+    if(refresh || processes.empty())
+        processes = findProcesses(processName);
+
+    return processes;
+}
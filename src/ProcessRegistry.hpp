@@ -0,0 +1,59 @@
+#ifndef PROCESSREGISTRY_H
+#define PROCESSREGISTRY_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ProcessBackend.hpp"
+
+// Owns the opened processes and remembers the last enumeration of the running
+// processes. Reloading a challenge reuses the process opened last time while it
+// is running, instead of enumerating and opening the processes again.
+class ProcessRegistry
+{
+    public:
+        static ProcessRegistry& getInstance();
+
+        // returns the running process whose main module is 'programFilename'
+        // returns nullptr if no such process is running
+        std::shared_ptr<ProcessBackend> open(const std::string &programFilename);
+
+        // returns every running process whose main module is 'programFilename', sorted by process ID
+        // the processes are always enumerated again, the ones opened before are reused while they are running
+        std::vector<std::shared_ptr<ProcessBackend>> openAll(const std::string &programFilename);
+
+        // returns the running processes whose main module is named 'processName'
+        // the processes are only enumerated again if 'refresh' is true or if none was found last time
+        std::vector<ProcessInfo> getProcesses(const std::string &processName, bool refresh = false);
+
+        // returns the folder (with a trailing separator) of the first process named 'processName',
+        // or an empty string
+        std::string getLocation(const std::string &processName);
+
+        // forgets the enumerations and the processes opened so far
+        // the processes stay open as long as a 'Process' uses them
+        void clear() noexcept;
+
+    private:
+        ProcessRegistry() = default;
+
+        std::vector<ProcessInfo>& enumerate(const std::string &processName, bool refresh);
+
+        struct OpenProcess
+        {
+            ProcessInfo info;
+            std::shared_ptr<ProcessBackend> backend;
+        };
+
+        std::mutex m_mutex;
+
+        // by process name
+        std::map<std::string, std::vector<ProcessInfo>> m_processes;
+
+        std::vector<OpenProcess> m_openProcesses;
+};
+
+#endif // PROCESSREGISTRY_H
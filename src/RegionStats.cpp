@@ -0,0 +1,95 @@
+#include "RegionStats.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <tuple>
+
+RegionClass RegionClass::of(const MemoryRegion &region) noexcept
+{
+    RegionClass regionClass;
+    regionClass.type = region.type;
+    regionClass.writable = region.writable;
+    regionClass.executable = region.executable;
+
+    for(auto size = region.size; size > 1; size /= 2)
+        ++regionClass.sizeClass;
+
+    return regionClass;
+}
+
+bool RegionClass::operator<(const RegionClass &other) const noexcept
+{
+    return std::make_tuple(type, writable, executable, sizeClass)
+        < std::make_tuple(other.type, other.writable, other.executable, other.sizeClass);
+}
+
+void RegionStats::open(const std::string &filename) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_filename = filename;
+    m_hits.clear();
+
+    std::ifstream ifs(filename);
+
+    // one class per line: type writable executable sizeClass hitCount
+    std::string line;
+    while(std::getline(ifs, line))
+    {
+        std::istringstream stream(line);
+        unsigned type;
+        RegionClass regionClass;
+        unsigned hitCount;
+        stream >> type >> regionClass.writable >> regionClass.executable >> regionClass.sizeClass >> hitCount;
+
+        if(stream && type <= static_cast<unsigned>(RegionType::Image))
+        {
+            regionClass.type = static_cast<RegionType>(type);
+            m_hits[regionClass] += hitCount;
+        }
+    }
+}
+
+void RegionStats::record(const std::vector<MemoryRegion> &regions, const std::vector<Address> &addresses) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for(auto address : addresses)
+    {
+        auto region = std::upper_bound(regions.begin(), regions.end(), address,
+            [](Address address, const MemoryRegion &region){ return address < region.base; });
+
+        if(region != regions.begin() && address < (--region)->end())
+            ++m_hits[RegionClass::of(*region)];
+    }
+
+    save();
+}
+
+std::vector<MemoryRegion> RegionStats::getLikelyRegions(const std::vector<MemoryRegion> &regions) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<MemoryRegion> likelyRegions;
+    std::copy_if(regions.begin(), regions.end(), std::back_inserter(likelyRegions),
+        [this](const MemoryRegion &region){ return m_hits.count(RegionClass::of(region)) != 0; });
+
+    return likelyRegions;
+}
+
+void RegionStats::save() const noexcept
+{
+    if(m_filename.empty())
+        return;
+
+    std::ofstream ofs(m_filename, std::ios::out | std::ios::trunc);
+
+    for(const auto &hits : m_hits)
+        ofs << static_cast<unsigned>(hits.first.type) << ' ' << hits.first.writable << ' ' << hits.first.executable << ' '
+            << hits.first.sizeClass << ' ' << hits.second << '\n';
+
+    if(!ofs)
+        std::cerr << "Warning: Failed to save region statistics into file \"" << m_filename << "\"!" << std::endl;
+}
@@ -0,0 +1,52 @@
+#ifndef REGIONSTATS_H
+#define REGIONSTATS_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ProcessBackend.hpp"
+
+// the kind of a memory region: its type, its protection and the order of magnitude of its size
+struct RegionClass
+{
+    RegionType type {RegionType::Private};
+    bool writable {false};
+    bool executable {false};
+
+    // log2 of the region size
+    unsigned sizeClass {0};
+
+    static RegionClass of(const MemoryRegion &region) noexcept;
+
+    bool operator<(const RegionClass &other) const noexcept;
+};
+
+// Counts the hits of the scans per region class, in memory and in a file.
+// The challenge structures always end up in the same kinds of regions, so the
+// next scans can search these regions first and fall back to every region
+// only if they don't hold the challenge anymore.
+// It can be shared by the challenges of several game instances.
+class RegionStats
+{
+    public:
+        // loads the hits saved into 'filename', the next hits are saved into it too
+        // a missing or corrupted file is considered empty
+        void open(const std::string &filename) noexcept;
+
+        // counts a hit in each region holding one of 'addresses', and saves the file
+        void record(const std::vector<MemoryRegion> &regions, const std::vector<Address> &addresses) noexcept;
+
+        // returns the regions whose class already held hits, sorted by address
+        std::vector<MemoryRegion> getLikelyRegions(const std::vector<MemoryRegion> &regions) const;
+
+    private:
+        void save() const noexcept;
+
+        mutable std::mutex m_mutex;
+        std::string m_filename;
+        std::map<RegionClass, unsigned> m_hits;
+};
+
+#endif // REGIONSTATS_H
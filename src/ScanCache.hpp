@@ -0,0 +1,57 @@
+#ifndef SCANCACHE_H
+#define SCANCACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "PatternSet.hpp"
+#include "ProcessBackend.hpp"
+
+// an occurrence of one of the patterns of a 'PatternSet'
+struct StringMatch
+{
+    Address address {0};
+    std::size_t pattern {0};
+};
+
+// What 'Process::findStrings' found during its last scan: a hash of each
+// page it read and the matches. The next scan with the same patterns only
+// searches the pages which changed (or whose next page changed, since a
+// match can straddle them), the matches of the other pages being reused.
+// The pages are identified by their address, so a scan of other regions
+// reuses the pages both scans read, the other ones count as changed.
+struct ScanCache
+{
+    struct Page
+    {
+        Address address;
+        std::uint64_t hash;
+    };
+
+    static const std::size_t pageSize {0x1000};
+
+    // key of the cache
+    unsigned processId {0};
+    std::uint64_t startTime {0};
+    std::vector<std::string> patterns;
+
+    // sorted by address
+    std::vector<Page> pages;
+    std::vector<StringMatch> matches;
+
+    // returns true if the cache holds a scan of these patterns
+    bool isValidFor(const PatternSet &patternSet) const noexcept
+    {
+        if(pages.empty() || patternSet.size() != patterns.size())
+            return false;
+
+        for(std::size_t i = 0; i < patterns.size(); ++i)
+            if(patternSet.getPattern(i) != patterns[i])
+                return false;
+
+        return true;
+    }
+};
+
+#endif // SCANCACHE_H
@@ -0,0 +1,107 @@
+#include "ScanControl.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+const std::chrono::milliseconds ScanControl::progressInterval {100};
+
+void ScanControl::start() noexcept
+{
+    m_cancelled = false;
+    m_startTime = SteadyClock::now();
+    m_spentBytes = 0;
+    m_lastReport = 0;
+}
+
+void ScanControl::cancel() noexcept
+{
+    m_cancelled = true;
+}
+
+bool ScanControl::isCancelled() const noexcept
+{
+    return m_cancelled;
+}
+
+void ScanControl::setTimeBudget(double seconds) noexcept
+{
+    // rounded up, so that a budget shorter than a millisecond is not taken as no limit
+    m_timeBudget = static_cast<long long>(std::ceil(seconds * 1000));
+}
+
+void ScanControl::setByteBudget(std::size_t size) noexcept
+{
+    m_byteBudget = size;
+}
+
+bool ScanControl::isStopped() const noexcept
+{
+    if(m_cancelled)
+        return true;
+
+    if(m_byteBudget != 0 && m_spentBytes >= m_byteBudget)
+        return true;
+
+    return m_timeBudget != 0 && getElapsedTime() >= m_timeBudget;
+}
+
+void ScanControl::check() const
+{
+    if(m_cancelled)
+        throw std::runtime_error("Loading cancelled.");
+
+    if(isStopped())
+        throw std::runtime_error("Loading stopped: the scan budget is exhausted.");
+}
+
+void ScanControl::setProgressCallback(ProgressCallback callback)
+{
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    m_callback = std::move(callback);
+}
+
+void ScanControl::beginScan(std::size_t totalSize, std::size_t blockCount) noexcept
+{
+    m_scannedSize = 0;
+    m_totalSize = totalSize;
+    m_remainingBlocks = blockCount;
+    m_candidateCount = 0;
+}
+
+void ScanControl::addProgress(std::size_t scannedSize, std::size_t candidateCount) noexcept
+{
+    m_scannedSize += scannedSize;
+    m_spentBytes += scannedSize;
+    m_candidateCount += candidateCount;
+    --m_remainingBlocks;
+
+    // a single thread reports, the others go on scanning
+    auto lastReport = m_lastReport.load();
+    const auto now = getElapsedTime();
+    if(now - lastReport >= progressInterval.count() && m_lastReport.compare_exchange_strong(lastReport, now))
+        report();
+}
+
+void ScanControl::endScan() noexcept
+{
+    m_lastReport = getElapsedTime();
+    report();
+}
+
+long long ScanControl::getElapsedTime() const noexcept
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(SteadyClock::now() - m_startTime).count();
+}
+
+void ScanControl::report() noexcept
+{
+    ScanProgress progress;
+    progress.scannedSize = m_scannedSize;
+    progress.totalSize = m_totalSize;
+    progress.remainingBlocks = m_remainingBlocks;
+    progress.candidateCount = m_candidateCount;
+
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    if(m_callback)
+        m_callback(progress);
+}
@@ -0,0 +1,83 @@
+#ifndef SCANCONTROL_H
+#define SCANCONTROL_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+// the progress of the running scan, as reported by 'ScanControl'
+struct ScanProgress
+{
+    std::size_t scannedSize {0};
+    std::size_t totalSize {0};
+    std::size_t remainingBlocks {0};
+    std::size_t candidateCount {0};
+};
+
+// Lets another thread stop the scans of a 'Process', limits them with a time
+// or byte budget, and reports their progress. The scans check it between two
+// blocks, so they return within milliseconds once it is stopped.
+class ScanControl
+{
+    public:
+        using ProgressCallback = std::function<void(const ScanProgress&)>;
+
+        // clears the cancellation and starts counting the budgets
+        // it must not be called while a scan is running
+        void start() noexcept;
+
+        // stops the running and next scans, it can be called from any thread
+        void cancel() noexcept;
+        bool isCancelled() const noexcept;
+
+        // the budgets are shared by the scans following 'start', 0 means no limit
+        void setTimeBudget(double seconds) noexcept;
+        void setByteBudget(std::size_t size) noexcept;
+
+        // returns true if the scans have to stop: cancelled, or out of budget
+        bool isStopped() const noexcept;
+
+        // throws an exception explaining why the scans stopped, if they did
+        void check() const;
+
+        // 'callback' is called from the scanning threads, at most once per 'progressInterval'
+        // and once at the end of each scan, it must not block
+        void setProgressCallback(ProgressCallback callback);
+
+        // used by 'Process' around and during its scans
+        void beginScan(std::size_t totalSize, std::size_t blockCount) noexcept;
+        void addProgress(std::size_t scannedSize, std::size_t candidateCount) noexcept;
+        void endScan() noexcept;
+
+        static const std::chrono::milliseconds progressInterval;
+
+    private:
+        using SteadyClock = std::chrono::steady_clock;
+
+        // returns the time elapsed since 'start', in milliseconds
+        long long getElapsedTime() const noexcept;
+
+        void report() noexcept;
+
+        std::atomic<bool> m_cancelled {false};
+        SteadyClock::time_point m_startTime {SteadyClock::now()};
+        std::atomic<long long> m_timeBudget {0};
+        std::atomic<std::size_t> m_byteBudget {0};
+
+        // bytes scanned since 'start'
+        std::atomic<std::size_t> m_spentBytes {0};
+
+        // running scan
+        std::atomic<std::size_t> m_scannedSize {0};
+        std::atomic<std::size_t> m_totalSize {0};
+        std::atomic<std::size_t> m_remainingBlocks {0};
+        std::atomic<std::size_t> m_candidateCount {0};
+
+        std::mutex m_callbackMutex;
+        ProgressCallback m_callback;
+        std::atomic<long long> m_lastReport {0};
+};
+
+#endif // SCANCONTROL_H
@@ -0,0 +1,214 @@
+#include "ScanPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<std::size_t> indices;
+    };
+
+    // the state of a 'ScanPool::run' call, shared with the workers which help it
+    struct Job
+    {
+        Job(std::size_t threadCount, const std::function<void(std::size_t)> &task) :
+            queues(threadCount), task(task)
+        {
+        }
+
+        // processes the indices of the queue 'self', then steals the others
+        void work(std::size_t self) noexcept;
+
+        std::vector<WorkQueue> queues;
+        const std::function<void(std::size_t)> &task;
+
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        // the queue given to the next helper, the first one belongs to the calling thread
+        std::atomic<std::size_t> nextQueue {1};
+
+        // the helpers which started are waited for, the others skip the job once it is closed
+        std::mutex stateMutex;
+        std::condition_variable finished;
+        unsigned helperCount {0};
+        bool closed {false};
+    };
+
+    void Job::work(std::size_t self) noexcept
+    {
+        auto pop = [this](std::size_t queue, bool front, std::size_t &index)
+        {
+            std::lock_guard<std::mutex> lock(queues[queue].mutex);
+            auto &indices = queues[queue].indices;
+            if(indices.empty())
+                return false;
+
+            index = front ? indices.front() : indices.back();
+            if(front)
+                indices.pop_front();
+            else
+                indices.pop_back();
+
+            return true;
+        };
+
+        try
+        {
+            std::size_t index;
+            while(true)
+            {
+                if(pop(self, true, index))
+                {
+                    task(index);
+                    continue;
+                }
+
+                bool stolen = false;
+                for(std::size_t i = 1; i < queues.size() && !stolen; ++i)
+                    stolen = pop((self + i) % queues.size(), false, index);
+
+                if(!stolen)
+                    break;
+
+                task(index);
+            }
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if(!error)
+                error = std::current_exception();
+        }
+    }
+
+    // the threads shared by every pool, started on demand
+    class Workers
+    {
+        public:
+            ~Workers()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_stopping = true;
+                }
+
+                m_wakeUp.notify_all();
+                for(auto &thread : m_threads)
+                    thread.join();
+            }
+
+            static Workers& getInstance()
+            {
+                static Workers workers;
+                return workers;
+            }
+
+            // asks 'helperCount' workers to help 'job', more workers are started if needed
+            void submit(const std::shared_ptr<Job> &job, std::size_t helperCount)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                while(m_threads.size() < helperCount)
+                    m_threads.emplace_back(&Workers::loop, this);
+
+                m_jobs.insert(m_jobs.end(), helperCount, job);
+                m_wakeUp.notify_all();
+            }
+
+        private:
+            void loop() noexcept
+            {
+                while(true)
+                {
+                    std::shared_ptr<Job> job;
+
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_wakeUp.wait(lock, [this]{ return m_stopping || !m_jobs.empty(); });
+
+                        if(m_jobs.empty())
+                            return;
+
+                        job = std::move(m_jobs.front());
+                        m_jobs.pop_front();
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(job->stateMutex);
+                        if(job->closed)
+                            continue;
+
+                        ++job->helperCount;
+                    }
+
+                    job->work(job->nextQueue++);
+
+                    {
+                        std::lock_guard<std::mutex> lock(job->stateMutex);
+                        --job->helperCount;
+                    }
+
+                    job->finished.notify_all();
+                }
+            }
+
+            std::mutex m_mutex;
+            std::condition_variable m_wakeUp;
+            std::deque<std::shared_ptr<Job>> m_jobs;
+            std::vector<std::thread> m_threads;
+            bool m_stopping {false};
+    };
+}
+
+ScanPool::ScanPool(unsigned threadCount) :
+    m_threadCount(threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency()))
+{
+}
+
+unsigned ScanPool::getThreadCount() const noexcept
+{
+    return m_threadCount;
+}
+
+void ScanPool::run(std::size_t count, const std::function<void(std::size_t)> &task) const
+{
+    const auto threadCount = static_cast<std::size_t>(std::min<std::size_t>(m_threadCount, count));
+
+    if(threadCount <= 1)
+    {
+        for(std::size_t index = 0; index < count; ++index)
+            task(index);
+
+        return;
+    }
+
+    auto job = std::make_shared<Job>(threadCount, task);
+    for(std::size_t i = 0; i < threadCount; ++i)
+        for(auto index = i * count / threadCount; index < (i + 1) * count / threadCount; ++index)
+            job->queues[i].indices.push_back(index);
+
+    Workers::getInstance().submit(job, threadCount - 1);
+
+    job->work(0);
+
+    // 'task' must not be used once this function returns
+    {
+        std::unique_lock<std::mutex> lock(job->stateMutex);
+        job->closed = true;
+        job->finished.wait(lock, [&job]{ return job->helperCount == 0; });
+    }
+
+    if(job->error)
+        std::rethrow_exception(job->error);
+}
@@ -0,0 +1,32 @@
+#ifndef SCANPOOL_H
+#define SCANPOOL_H
+
+#include <functional>
+#include <cstddef>
+
+// Runs indexed tasks on several threads.
+// Each thread gets a contiguous range of indices which it processes in ascending
+// order. Once its range is exhausted, it steals the last indices of the other ranges,
+// so that the threads keep working on the beginning of their own range.
+// The worker threads are shared by every pool of the program and live until it exits,
+// so that the scans of several processes don't start more threads than needed and
+// keep the buffers of the previous scans.
+class ScanPool
+{
+    public:
+        // if 'threadCount' is 0, one thread per hardware thread is used
+        ScanPool(unsigned threadCount = 0);
+
+        unsigned getThreadCount() const noexcept;
+
+        // calls 'task(index)' for each index in [0, count) and returns once they are all done
+        // the calling thread takes part, so the tasks are done even if the workers are busy
+        // if a task throws an exception, it is rethrown by this function
+        // throws 'std::system_error' if the worker threads can't be started
+        void run(std::size_t count, const std::function<void(std::size_t)> &task) const;
+
+    private:
+        unsigned m_threadCount;
+};
+
+#endif // SCANPOOL_H
@@ -0,0 +1,102 @@
+#include "ScanStats.hpp"
+
+#include <sstream>
+
+#include "Json.hpp"
+
+namespace
+{
+    // names of the counters, in JSON and in the output
+    const std::array<std::pair<const char*, const char*>, ScanStats::counterCount> counterNames {{
+        {"backendCalls", "Backend calls"},
+        {"bytesRead", "Bytes read"},
+        {"failedReads", "Failed reads"},
+        {"scannedBytes", "Bytes scanned"},
+        {"skippedRegions", "Regions skipped"},
+        {"skippedPages", "Unchanged pages skipped"},
+        {"candidateHits", "Candidate hits"},
+        {"signatureChecks", "Signature checks"},
+        {"retries", "Retries"}}};
+}
+
+ScanStats::ScanStats()
+{
+    reset();
+}
+
+void ScanStats::reset()
+{
+    for(auto &counter : m_counters)
+        counter = 0;
+
+    m_phases.clear();
+    m_properties.clear();
+}
+
+void ScanStats::add(Counter counter, std::uint64_t value) noexcept
+{
+    m_counters[counter].fetch_add(value, std::memory_order_relaxed);
+}
+
+std::uint64_t ScanStats::get(Counter counter) const noexcept
+{
+    return m_counters[counter];
+}
+
+void ScanStats::addPhase(const std::string &name, float seconds)
+{
+    m_phases.emplace_back(name, seconds);
+}
+
+void ScanStats::setProperty(const std::string &name, const std::string &value)
+{
+    m_properties[name] = value;
+}
+
+void ScanStats::print(std::ostream &os) const
+{
+    os << "Load statistics:" << std::endl << std::dec;
+
+    for(const auto &property : m_properties)
+        os << "> " << property.first << ": " << property.second << std::endl;
+
+    for(std::size_t i = 0; i < counterCount; ++i)
+        os << "> " << counterNames[i].second << ": " << m_counters[i] << std::endl;
+
+    for(const auto &phase : m_phases)
+        os << "> " << phase.first << ": " << phase.second << " seconds" << std::endl;
+}
+
+std::string ScanStats::toJson() const
+{
+    std::ostringstream json;
+    json << "{\n    \"properties\": {";
+
+    const char *separator = "";
+    for(const auto &property : m_properties)
+    {
+        json << separator << "\n        " << toJsonString(property.first) << ": " << toJsonString(property.second);
+        separator = ",";
+    }
+
+    json << "\n    },\n    \"counters\": {";
+
+    separator = "";
+    for(std::size_t i = 0; i < counterCount; ++i)
+    {
+        json << separator << "\n        \"" << counterNames[i].first << "\": " << m_counters[i];
+        separator = ",";
+    }
+
+    json << "\n    },\n    \"phases\": [";
+
+    separator = "";
+    for(const auto &phase : m_phases)
+    {
+        json << separator << "\n        {\"name\": " << toJsonString(phase.first) << ", \"seconds\": " << toJsonNumber(phase.second) << "}";
+        separator = ",";
+    }
+
+    json << "\n    ]\n}\n";
+    return json.str();
+}
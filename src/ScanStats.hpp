@@ -0,0 +1,58 @@
+#ifndef SCANSTATS_H
+#define SCANSTATS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Counters of the work done by 'Process' and 'Challenge' during a load, to see
+// why a load is slow and to compare machines and builds of the game.
+// The counters can be incremented from the scanning threads.
+class ScanStats
+{
+    public:
+        enum Counter
+        {
+            BackendCalls,
+            BytesRead,
+            FailedReads,
+            ScannedBytes,
+            SkippedRegions,
+            SkippedPages,
+            CandidateHits,
+            SignatureChecks,
+            Retries,
+            counterCount
+        };
+
+        ScanStats();
+
+        // clears the counters, the phases and the properties
+        void reset();
+
+        void add(Counter counter, std::uint64_t value = 1) noexcept;
+        std::uint64_t get(Counter counter) const noexcept;
+
+        // records the time spent in a phase of the load
+        void addPhase(const std::string &name, float seconds);
+
+        // records something which identifies the machine or the game
+        void setProperty(const std::string &name, const std::string &value);
+
+        // writes everything, one line per value
+        void print(std::ostream &os) const;
+
+        std::string toJson() const;
+
+    private:
+        std::array<std::atomic<std::uint64_t>, counterCount> m_counters;
+        std::vector<std::pair<std::string, float>> m_phases;
+        std::map<std::string, std::string> m_properties;
+};
+
+#endif // SCANSTATS_H
@@ -0,0 +1,139 @@
+#include "Signature.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include "ByteSearch.hpp"
+
+Signature::Signature(const std::string &pattern)
+{
+    std::istringstream stream(pattern);
+    std::string token;
+
+    while(stream >> token)
+    {
+        if(token == "??" || token == "?")
+        {
+            m_bytes.push_back(0);
+            m_mask.push_back(0);
+            continue;
+        }
+
+        std::size_t end {0};
+        unsigned long value {0};
+        try
+        {
+            value = std::stoul(token, &end, 16);
+        }
+        catch(const std::exception&)
+        {
+            end = 0;
+        }
+
+        if(token.size() != 2 || end != token.size() || value > 0xFF)
+            throw std::invalid_argument("Invalid byte \"" + token + "\" in signature \"" + pattern + "\".");
+
+        m_bytes.push_back(static_cast<char>(value));
+        m_mask.push_back(static_cast<char>(0xFF));
+    }
+
+    if(m_bytes.empty())
+        throw std::invalid_argument("Empty signature.");
+
+    // the anchor is the longest run of known bytes, trimmed of its zeros:
+    // zeros are so common in memory that they are a poor filter
+    // runs made of zeros only are taken if nothing better exists
+    auto isZero = [this](std::size_t i){ return m_bytes[i] == 0; };
+
+    bool anchorHasValue {false};
+    for(std::size_t i = 0; i < m_bytes.size();)
+    {
+        if(!m_mask[i])
+        {
+            ++i;
+            continue;
+        }
+
+        auto first = i;
+        auto last = i;
+        while(last < m_bytes.size() && m_mask[last])
+            ++last;
+
+        i = last;
+
+        auto trimmedFirst = first;
+        auto trimmedLast = last;
+        while(trimmedFirst < trimmedLast && isZero(trimmedFirst))
+            ++trimmedFirst;
+        while(trimmedLast > trimmedFirst && isZero(trimmedLast - 1))
+            --trimmedLast;
+
+        const bool hasValue = trimmedFirst != trimmedLast;
+        if(hasValue)
+        {
+            first = trimmedFirst;
+            last = trimmedLast;
+        }
+
+        if((hasValue && !anchorHasValue) || (hasValue == anchorHasValue && last - first > m_anchorLength))
+        {
+            m_anchorOffset = first;
+            m_anchorLength = last - first;
+            anchorHasValue = hasValue;
+        }
+    }
+}
+
+std::size_t Signature::size() const noexcept
+{
+    return m_bytes.size();
+}
+
+bool Signature::matches(const char *data) const noexcept
+{
+    // compares 8 bytes at a time
+    std::size_t i {0};
+    for(; i + 8 <= m_bytes.size(); i += 8)
+    {
+        std::uint64_t value, mask, bytes;
+        std::memcpy(&value, data + i, 8);
+        std::memcpy(&mask, m_mask.data() + i, 8);
+        std::memcpy(&bytes, m_bytes.data() + i, 8);
+
+        if((value & mask) != bytes)
+            return false;
+    }
+
+    for(; i < m_bytes.size(); ++i)
+        if((data[i] & m_mask[i]) != m_bytes[i])
+            return false;
+
+    return true;
+}
+
+const char* Signature::search(const char *first, const char *last) const noexcept
+{
+    if(last - first < static_cast<std::ptrdiff_t>(size()))
+        return last;
+
+    // a signature made of unknown bytes only matches anywhere
+    if(m_anchorLength == 0)
+        return first;
+
+    // the anchor is only searched where the whole signature fits
+    const auto anchorFirst = first + m_anchorOffset;
+    const auto anchorLast = last - (size() - m_anchorOffset - m_anchorLength);
+    const auto anchor = m_bytes.data() + m_anchorOffset;
+
+    for(auto it = anchorFirst; ; ++it)
+    {
+        it = searchBytes(it, anchorLast, anchor, m_anchorLength);
+        if(it == anchorLast)
+            return last;
+
+        if(matches(it - m_anchorOffset))
+            return it - m_anchorOffset;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef SIGNATURE_H
+#define SIGNATURE_H
+
+#include <string>
+#include <vector>
+
+// A byte pattern which may contain unknown bytes, written the same way as
+// the IDA signatures: "01 00 00 00 ?? ?? ?? ?? 00 00 00 00"
+// The signature is searched through its most selective run of known bytes
+// with the vectorized byte search, the whole pattern being only compared
+// where this run is found.
+class Signature
+{
+    public:
+        // throws std::invalid_argument if the pattern is malformed
+        Signature(const std::string &pattern);
+
+        std::size_t size() const noexcept;
+
+        // returns true if the 'size()' bytes located at 'data' match the signature
+        bool matches(const char *data) const noexcept;
+
+        // returns a pointer to the first match in [first, last)
+        // if the signature is not found, 'last' is returned
+        const char* search(const char *first, const char *last) const noexcept;
+
+    private:
+        // known bytes, the unknown ones being zeroed
+        std::vector<char> m_bytes;
+
+        // 0xFF for the known bytes, 0x00 for the unknown ones
+        std::vector<char> m_mask;
+
+        // run of known bytes searched first
+        std::size_t m_anchorOffset {0};
+        std::size_t m_anchorLength {0};
+};
+
+#endif // SIGNATURE_H
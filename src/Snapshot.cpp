@@ -0,0 +1,360 @@
+#include "Snapshot.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <QFile>
+
+#include "Hash.hpp"
+
+namespace
+{
+    const char magic[8] {'R', 'L', 'C', 'M', 'S', 'N', 'A', 'P'};
+    const std::uint32_t version {1};
+    const std::size_t pageSize {0x1000};
+    const std::uint32_t zeroPage {0xFFFF'FFFF};
+
+    // amount of memory read at once when saving a snapshot
+    const std::size_t blockSize {0x10'0000};
+
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t processId;
+        std::uint32_t regionCount;
+        std::uint32_t pageCount;
+        std::uint64_t pageTableOffset;
+        std::uint64_t pageStoreOffset;
+        char moduleName[64];
+    };
+
+    const std::uint32_t writableFlag {0x1};
+    const std::uint32_t executableFlag {0x2};
+    const std::uint32_t mappedFlag {0x4};
+    const std::uint32_t imageFlag {0x8};
+
+    struct Region
+    {
+        std::uint64_t base;
+        std::uint64_t size;
+        std::uint32_t flags;
+        std::uint32_t firstPage;
+    };
+
+    std::size_t getPageCount(std::uint64_t size) noexcept
+    {
+        return static_cast<std::size_t>((size + pageSize - 1) / pageSize);
+    }
+
+    class SnapshotProcessBackend : public ProcessBackend
+    {
+        public:
+            SnapshotProcessBackend(const std::string &filename) :
+                m_file(QString::fromStdString(filename))
+            {
+                if(!m_file.open(QIODevice::ReadOnly))
+                    throw std::runtime_error("Can't open snapshot \"" + filename + "\"!");
+
+                const auto size = static_cast<std::uint64_t>(m_file.size());
+                m_data = reinterpret_cast<const char*>(m_file.map(0, m_file.size()));
+
+                if(m_data == nullptr || size < sizeof(Header))
+                    throw std::runtime_error("Can't map snapshot \"" + filename + "\"!");
+
+                std::memcpy(&m_header, m_data, sizeof(m_header));
+
+                const auto tableEnd = m_header.pageTableOffset + std::uint64_t {m_header.pageCount} * sizeof(std::uint32_t);
+                if(!std::equal(std::begin(magic), std::end(magic), m_header.magic) || m_header.version != version
+                    || sizeof(Header) + std::uint64_t {m_header.regionCount} * sizeof(Region) > m_header.pageTableOffset
+                    || tableEnd > size || m_header.pageStoreOffset > size)
+                        throw std::runtime_error("Snapshot \"" + filename + "\" is corrupted!");
+
+                m_regions.resize(m_header.regionCount);
+                std::memcpy(m_regions.data(), m_data + sizeof(Header), m_regions.size() * sizeof(Region));
+
+                m_pageTable.resize(m_header.pageCount);
+                std::memcpy(m_pageTable.data(), m_data + m_header.pageTableOffset, m_pageTable.size() * sizeof(std::uint32_t));
+
+                const auto storedPages = (size - m_header.pageStoreOffset) / pageSize;
+                for(const auto &region : m_regions)
+                    if(region.firstPage + getPageCount(region.size) > m_pageTable.size())
+                        throw std::runtime_error("Snapshot \"" + filename + "\" is corrupted!");
+
+                for(auto page : m_pageTable)
+                    if(page != zeroPage && page >= storedPages)
+                        throw std::runtime_error("Snapshot \"" + filename + "\" is corrupted!");
+            }
+
+            bool read(Address address, char *buffer, std::size_t length) noexcept override
+            {
+                // the scans of a snapshot which was never written into don't wait for each other
+                const bool hasWrittenPages = m_hasWrittenPages;
+                std::unique_lock<std::mutex> lock(m_writtenPagesMutex, std::defer_lock);
+                if(hasWrittenPages)
+                    lock.lock();
+
+                return forEachPage(address, length, hasWrittenPages, [&buffer](std::size_t, const char *page, std::size_t offset, std::size_t size)
+                {
+                    if(page == nullptr)
+                        std::fill_n(buffer, size, 0);
+                    else
+                        std::copy_n(page + offset, size, buffer);
+
+                    buffer += size;
+                });
+            }
+
+            bool write(Address address, const char *buffer, std::size_t length) noexcept override
+            {
+                try
+                {
+                    std::lock_guard<std::mutex> lock(m_writtenPagesMutex);
+                    m_hasWrittenPages = true;
+
+                    // the written pages get their own copy, the stored pages can be shared
+                    // they are all copied before the first byte is written, so that a failed allocation changes nothing
+                    const bool copied = forEachPage(address, length, true, [this](std::size_t index, const char *page, std::size_t, std::size_t)
+                    {
+                        if(m_writtenPages.count(index))
+                            return;
+
+                        std::vector<char> writtenPage(pageSize, 0);
+                        if(page != nullptr)
+                            std::copy_n(page, pageSize, writtenPage.begin());
+
+                        m_writtenPages.emplace(index, std::move(writtenPage));
+                    });
+
+                    if(!copied)
+                        return false;
+
+                    return forEachPage(address, length, true, [this, &buffer](std::size_t index, const char*, std::size_t offset, std::size_t size)
+                    {
+                        std::copy_n(buffer, size, m_writtenPages[index].begin() + offset);
+                        buffer += size;
+                    });
+                }
+                catch(const std::bad_alloc&)
+                {
+                    return false;
+                }
+            }
+
+            std::vector<MemoryRegion> getRegions() noexcept override
+            {
+                std::vector<MemoryRegion> regions;
+                for(const auto &entry : m_regions)
+                {
+                    MemoryRegion region;
+                    region.base = static_cast<Address>(entry.base);
+                    region.size = static_cast<std::size_t>(entry.size);
+                    region.writable = entry.flags & writableFlag;
+                    region.executable = entry.flags & executableFlag;
+                    region.type = entry.flags & imageFlag ? RegionType::Image
+                        : entry.flags & mappedFlag ? RegionType::Mapped : RegionType::Private;
+
+                    regions.push_back(region);
+                }
+
+                return regions;
+            }
+
+            unsigned getProcessId() const noexcept override
+            {
+                return m_header.processId;
+            }
+
+            std::string getModuleName() noexcept override
+            {
+                return std::string(m_header.moduleName, strnlen(m_header.moduleName, sizeof(m_header.moduleName)));
+            }
+
+            // the snapshots don't hold the modules and the launch of the process
+            std::vector<Module> getModules() noexcept override
+            {
+                return std::vector<Module>();
+            }
+
+            std::uint64_t getStartTime() noexcept override
+            {
+                return 0;
+            }
+
+            bool isAlive() noexcept override
+            {
+                return true;
+            }
+
+        private:
+            // calls 'function(index, page, offset, size)' for each page holding a part of [address, address + length)
+            // 'page' is nullptr for the zero pages, the written pages are looked for if 'hasWrittenPages' is true
+            // returns false if a part of the area is not in the snapshot
+            template<typename Function> bool forEachPage(Address address, std::size_t length, bool hasWrittenPages, Function function) const
+            {
+                while(length > 0)
+                {
+                    auto region = std::upper_bound(m_regions.begin(), m_regions.end(), address,
+                        [](Address address, const Region &region){ return address < region.base; });
+
+                    if(region == m_regions.begin())
+                        return false;
+
+                    --region;
+                    if(address - region->base >= region->size)
+                        return false;
+
+                    const auto regionOffset = static_cast<std::size_t>(address - region->base);
+                    const auto index = region->firstPage + regionOffset / pageSize;
+                    const auto offset = regionOffset % pageSize;
+                    const auto size = std::min({length, pageSize - offset, static_cast<std::size_t>(region->size) - regionOffset});
+
+                    function(index, getPage(index, hasWrittenPages), offset, size);
+
+                    address += size;
+                    length -= size;
+                }
+
+                return true;
+            }
+
+            const char* getPage(std::size_t index, bool hasWrittenPages) const noexcept
+            {
+                const auto written = hasWrittenPages ? m_writtenPages.find(index) : m_writtenPages.end();
+                if(written != m_writtenPages.end())
+                    return written->second.data();
+
+                if(m_pageTable[index] == zeroPage)
+                    return nullptr;
+
+                return m_data + m_header.pageStoreOffset + std::uint64_t {m_pageTable[index]} * pageSize;
+            }
+
+            QFile m_file;
+            const char *m_data {nullptr};
+
+            Header m_header;
+            std::vector<Region> m_regions;
+            std::vector<std::uint32_t> m_pageTable;
+
+            // pages modified through 'write', by page index
+            std::unordered_map<std::size_t, std::vector<char>> m_writtenPages;
+            std::mutex m_writtenPagesMutex;
+            std::atomic<bool> m_hasWrittenPages {false};
+    };
+}
+
+void saveSnapshot(ProcessBackend &process, const std::string &filename)
+{
+    std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!file)
+        throw std::runtime_error("Can't create snapshot \"" + filename + "\"!");
+
+    const auto regions = process.getRegions();
+
+    Header header {};
+    std::copy(std::begin(magic), std::end(magic), header.magic);
+    header.version = version;
+    header.processId = process.getProcessId();
+    header.regionCount = static_cast<std::uint32_t>(regions.size());
+
+    const auto moduleName = process.getModuleName();
+    std::copy_n(moduleName.begin(), std::min(moduleName.size(), sizeof(header.moduleName) - 1), header.moduleName);
+
+    std::vector<Region> entries;
+    for(const auto &region : regions)
+    {
+        Region entry {};
+        entry.base = region.base;
+        entry.size = region.size;
+        entry.flags = (region.writable ? writableFlag : 0u) | (region.executable ? executableFlag : 0u)
+            | (region.type == RegionType::Mapped ? mappedFlag : 0u) | (region.type == RegionType::Image ? imageFlag : 0u);
+        entry.firstPage = header.pageCount;
+
+        header.pageCount += static_cast<std::uint32_t>(getPageCount(region.size));
+        entries.push_back(entry);
+    }
+
+    header.pageTableOffset = sizeof(Header) + entries.size() * sizeof(Region);
+    header.pageStoreOffset = (header.pageTableOffset + header.pageCount * sizeof(std::uint32_t) + pageSize - 1) / pageSize * pageSize;
+
+    std::vector<std::uint32_t> pageTable;
+    pageTable.reserve(header.pageCount);
+
+    // stored pages by hash, the pages having the same hash are compared to find the duplicates
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> storedPages;
+    std::uint32_t storedCount {0};
+
+    const std::array<char, pageSize> zeros {};
+    std::array<char, pageSize> storedPage;
+    std::vector<char> block(blockSize);
+
+    file.seekp(static_cast<std::streamoff>(header.pageStoreOffset));
+
+    for(const auto &region : regions)
+    {
+        for(std::size_t offset = 0; offset < region.size; offset += blockSize)
+        {
+            const auto length = std::min(blockSize, region.size - offset);
+            std::fill(block.begin(), block.end(), 0);
+            const bool blockRead = process.read(region.base + offset, block.data(), length);
+
+            for(std::size_t pageOffset = 0; pageOffset < length; pageOffset += pageSize)
+            {
+                const auto page = block.data() + pageOffset;
+                const auto size = std::min(pageSize, length - pageOffset);
+
+                // the pages which can't be read anymore are saved as zero pages
+                if(!blockRead && !process.read(region.base + offset + pageOffset, page, size))
+                    std::fill_n(page, size, 0);
+
+                if(std::equal(page, page + pageSize, zeros.begin()))
+                {
+                    pageTable.push_back(zeroPage);
+                    continue;
+                }
+
+                auto &candidates = storedPages[hashBytes(page, pageSize)];
+                auto duplicate = std::find_if(candidates.begin(), candidates.end(), [&](std::uint32_t index)
+                {
+                    file.seekg(static_cast<std::streamoff>(header.pageStoreOffset + std::uint64_t {index} * pageSize));
+                    file.read(storedPage.data(), storedPage.size());
+                    return std::equal(page, page + pageSize, storedPage.begin());
+                });
+
+                if(duplicate != candidates.end())
+                {
+                    pageTable.push_back(*duplicate);
+                    continue;
+                }
+
+                file.seekp(static_cast<std::streamoff>(header.pageStoreOffset + std::uint64_t {storedCount} * pageSize));
+                file.write(page, pageSize);
+
+                candidates.push_back(storedCount);
+                pageTable.push_back(storedCount++);
+            }
+        }
+    }
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Region));
+    file.write(reinterpret_cast<const char*>(pageTable.data()), pageTable.size() * sizeof(std::uint32_t));
+
+    if(!file)
+        throw std::runtime_error("Failed to write snapshot \"" + filename + "\"!");
+}
+
+std::unique_ptr<ProcessBackend> openSnapshot(const std::string &filename)
+{
+    return std::unique_ptr<ProcessBackend>(new SnapshotProcessBackend(filename));
+}
@@ -0,0 +1,29 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "ProcessBackend.hpp"
+
+// Memory snapshots hold the readable regions of a process, so that the
+// scans can be reproduced and measured without the game.
+//
+// File layout (integers are little endian):
+//   header       magic "RLCMSNAP", version, process ID, module name,
+//                region count, page count, page table and page store offsets
+//   regions      base, size and flags of each region
+//   page table   index of each page of the regions in the page store,
+//                or 0xFFFFFFFF for the pages filled with zeros
+//   page store   unique pages of 0x1000 bytes, aligned on 0x1000 bytes
+//
+// Zero pages are not stored and identical pages are only stored once.
+// The file is mapped when it is opened, the pages being read straight from it.
+
+// saves the readable regions of the process into 'filename'
+// throws std::runtime_error on failure
+void saveSnapshot(ProcessBackend &process, const std::string &filename);
+
+// opens a snapshot as a process whose memory is the content of the snapshot
+// the writes are kept in memory, the file is never modified
+// throws std::runtime_error on failure
+std::unique_ptr<ProcessBackend> openSnapshot(const std::string &filename);
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,300 @@
+#include "ProcessBackend.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include <windows.h>
+#include <tlhelp32.h>
+#include <psapi.h>
+
+namespace
+{
+    std::string wstrToStr(const std::wstring &ws)
+    {
+        std::string str(ws.begin(), ws.end());
+        return str;
+    }
+
+    // closes the handle it owns when it is destroyed
+    class Handle
+    {
+        public:
+            explicit Handle(HANDLE handle = nullptr) noexcept :
+                m_handle(handle)
+            {
+            }
+
+            ~Handle()
+            {
+                if(isValid())
+                    CloseHandle(m_handle);
+            }
+
+            Handle(const Handle&) = delete;
+            Handle& operator=(const Handle&) = delete;
+
+            HANDLE get() const noexcept
+            {
+                return m_handle;
+            }
+
+            bool isValid() const noexcept
+            {
+                return m_handle != nullptr && m_handle != INVALID_HANDLE_VALUE;
+            }
+
+            // gives the ownership of the handle to the caller
+            HANDLE release() noexcept
+            {
+                auto handle = m_handle;
+                m_handle = nullptr;
+                return handle;
+            }
+
+        private:
+            HANDLE m_handle;
+    };
+
+    // returns the creation time of the process, or 0 on failure
+    std::uint64_t getCreationTime(HANDLE processHandle)
+    {
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        if(!GetProcessTimes(processHandle, &creationTime, &exitTime, &kernelTime, &userTime))
+            return 0;
+
+        return (std::uint64_t {creationTime.dwHighDateTime} << 32) | creationTime.dwLowDateTime;
+    }
+
+    class WindowsProcessBackend : public ProcessBackend
+    {
+        public:
+            WindowsProcessBackend(HANDLE processHandle, const ProcessInfo &process) :
+                m_processHandle(processHandle), m_processId(process.processId), m_startTime(process.startTime)
+            {
+            }
+
+            bool read(Address address, char *buffer, std::size_t length) noexcept override
+            {
+                return ReadProcessMemory(m_processHandle.get(), reinterpret_cast<void*>(address),
+                    buffer, length, nullptr);
+            }
+
+            std::size_t readBatch(ReadRequest *requests, std::size_t count) noexcept override
+            {
+                // the requests which are close to each other are read with a single call
+                // if such a read fails, its requests are read one by one
+                std::vector<ReadRequest*> sorted(count);
+                for(std::size_t i = 0; i < count; ++i)
+                    sorted[i] = &requests[i];
+
+                std::sort(sorted.begin(), sorted.end(),
+                    [](const ReadRequest *a, const ReadRequest *b){ return a->address < b->address; });
+
+                thread_local std::vector<char> buffer;
+                std::size_t successCount {0};
+
+                for(auto first = sorted.begin(); first != sorted.end();)
+                {
+                    const auto spanFirst = (*first)->address;
+                    auto spanLast = spanFirst + (*first)->length;
+
+                    auto last = first + 1;
+                    for(; last != sorted.end() && (*last)->address <= spanLast + maxBatchGap
+                        && (*last)->address + (*last)->length - spanFirst <= maxBatchSpan; ++last)
+                        spanLast = std::max(spanLast, (*last)->address + (*last)->length);
+
+                    buffer.resize(spanLast - spanFirst);
+                    const bool spanRead = last - first > 1 && read(spanFirst, buffer.data(), buffer.size());
+
+                    for(auto it = first; it != last; ++it)
+                    {
+                        auto &request = **it;
+                        if(spanRead)
+                            std::copy_n(buffer.data() + (request.address - spanFirst), request.length, request.buffer);
+
+                        request.success = spanRead || read(request.address, request.buffer, request.length);
+                        successCount += request.success;
+                    }
+
+                    first = last;
+                }
+
+                return successCount;
+            }
+
+            bool write(Address address, const char *buffer, std::size_t length) noexcept override
+            {
+                return WriteProcessMemory(m_processHandle.get(), reinterpret_cast<void*>(address),
+                    buffer, length, nullptr);
+            }
+
+            std::vector<MemoryRegion> getRegions() noexcept override
+            {
+                auto isReadable = [](DWORD protect)
+                {
+                    if(protect & (PAGE_GUARD | PAGE_NOACCESS))
+                        return false;
+
+                    return (protect & (PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY
+                        | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY)) != 0;
+                };
+
+                std::vector<MemoryRegion> regions;
+
+                MEMORY_BASIC_INFORMATION info;
+                Address address {0};
+
+                while(VirtualQueryEx(m_processHandle.get(), reinterpret_cast<void*>(address), &info, sizeof(info)) == sizeof(info))
+                {
+                    const auto base = reinterpret_cast<Address>(info.BaseAddress);
+
+                    if(info.State == MEM_COMMIT && isReadable(info.Protect))
+                    {
+                        MemoryRegion region;
+                        region.base = base;
+                        region.size = info.RegionSize;
+                        region.writable = (info.Protect & (PAGE_READWRITE | PAGE_WRITECOPY
+                            | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY)) != 0;
+                        region.executable = (info.Protect & (PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE
+                            | PAGE_EXECUTE_WRITECOPY)) != 0;
+                        region.type = info.Type == MEM_IMAGE ? RegionType::Image
+                            : info.Type == MEM_MAPPED ? RegionType::Mapped : RegionType::Private;
+
+                        regions.push_back(region);
+                    }
+
+                    // the last region ends at the top of the address space
+                    if(static_cast<Address>(-1) - base < info.RegionSize || info.RegionSize == 0)
+                        break;
+
+                    address = base + info.RegionSize;
+                }
+
+                return regions;
+            }
+
+            unsigned getProcessId() const noexcept override
+            {
+                return m_processId;
+            }
+
+            std::string getModuleName() noexcept override
+            {
+                std::wstring moduleName(MAX_PATH, 0);
+                auto strSize = GetModuleBaseName(m_processHandle.get(), nullptr, &moduleName[0], MAX_PATH);
+                moduleName.erase(strSize);
+
+                return wstrToStr(moduleName);
+            }
+
+            std::vector<Module> getModules() noexcept override
+            {
+                std::vector<Module> modules;
+
+                // the main module is always listed first
+                std::vector<HMODULE> handles(256);
+                DWORD size;
+                if(!EnumProcessModulesEx(m_processHandle.get(), handles.data(), handles.size() * sizeof(HMODULE), &size, LIST_MODULES_ALL))
+                    return modules;
+
+                if(size > handles.size() * sizeof(HMODULE))
+                {
+                    handles.resize(size / sizeof(HMODULE));
+                    if(!EnumProcessModulesEx(m_processHandle.get(), handles.data(), handles.size() * sizeof(HMODULE), &size, LIST_MODULES_ALL))
+                        return modules;
+                }
+
+                handles.resize(std::min<std::size_t>(handles.size(), size / sizeof(HMODULE)));
+
+                for(auto handle : handles)
+                {
+                    MODULEINFO info;
+                    if(!GetModuleInformation(m_processHandle.get(), handle, &info, sizeof(info)))
+                        continue;
+
+                    std::wstring moduleName(MAX_PATH, 0);
+                    auto strSize = GetModuleBaseName(m_processHandle.get(), handle, &moduleName[0], MAX_PATH);
+                    moduleName.erase(strSize);
+
+                    Module module;
+                    module.name = wstrToStr(moduleName);
+                    module.base = reinterpret_cast<Address>(info.lpBaseOfDll);
+                    module.size = info.SizeOfImage;
+
+                    modules.push_back(module);
+                }
+
+                return modules;
+            }
+
+            std::uint64_t getStartTime() noexcept override
+            {
+                return m_startTime;
+            }
+
+            bool isAlive() noexcept override
+            {
+                return WaitForSingleObject(m_processHandle.get(), 0) == WAIT_TIMEOUT;
+            }
+
+        private:
+            // the requests are gathered if they are separated by less than 'maxBatchGap' bytes
+            // and if they fit into 'maxBatchSpan' bytes
+            static const std::size_t maxBatchGap {0x100};
+            static const std::size_t maxBatchSpan {0x1'0000};
+
+            Handle m_processHandle;
+            DWORD m_processId;
+            std::uint64_t m_startTime;
+    };
+}
+
+std::vector<ProcessInfo> findProcesses(const std::string &processName)
+{
+    std::vector<ProcessInfo> processes;
+
+    Handle snapshot(CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0));
+    if(!snapshot.isValid())
+        return processes;
+
+    // the name is converted once instead of converting the name of every process
+    const std::wstring wideProcessName(processName.begin(), processName.end());
+
+    PROCESSENTRY32 entry;
+    entry.dwSize = sizeof(PROCESSENTRY32);
+
+    for(auto found = Process32First(snapshot.get(), &entry); found; found = Process32Next(snapshot.get(), &entry))
+    {
+        if(wideProcessName != entry.szExeFile)
+            continue;
+
+        Handle processHandle(OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, false, entry.th32ProcessID));
+        if(!processHandle.isValid())
+            continue;
+
+        std::wstring filename(MAX_PATH, 0);
+        DWORD strSize {MAX_PATH};
+        if(!QueryFullProcessImageName(processHandle.get(), 0, &filename[0], &strSize))
+            continue;
+
+        filename.erase(strSize);
+
+        ProcessInfo process;
+        process.processId = entry.th32ProcessID;
+        process.filename = wstrToStr(filename);
+        process.startTime = getCreationTime(processHandle.get());
+
+        processes.push_back(process);
+    }
+
+    return processes;
+}
+
+std::unique_ptr<ProcessBackend> openProcessBackend(const ProcessInfo &process)
+{
+    Handle processHandle(OpenProcess(PROCESS_ALL_ACCESS, false, process.processId));
+    if(!processHandle.isValid() || getCreationTime(processHandle.get()) != process.startTime)
+        return nullptr;
+
+    return std::unique_ptr<ProcessBackend>(new WindowsProcessBackend(processHandle.release(), process));
+}
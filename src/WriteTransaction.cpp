@@ -0,0 +1,94 @@
+#include "WriteTransaction.hpp"
+
+WriteTransaction::WriteTransaction(Process &process) :
+    m_process(process)
+{
+}
+
+void WriteTransaction::write(Address address, const char *data, std::size_t length)
+{
+    m_writes.push_back({address, m_data.size(), length});
+    m_data.insert(m_data.end(), data, data + length);
+}
+
+void WriteTransaction::commit()
+{
+    // the areas are the union of the writes, sorted by address
+    std::vector<Write> writes = m_writes;
+    std::sort(writes.begin(), writes.end(),
+        [](const Write &a, const Write &b){ return a.address < b.address; });
+
+    std::vector<Write> areas;
+    std::size_t areaSize {0};
+
+    for(const auto &write : writes)
+    {
+        if(!areas.empty() && write.address <= areas.back().address + areas.back().length)
+        {
+            auto &area = areas.back();
+            const auto end = std::max(area.address + area.length, write.address + write.length);
+            areaSize += end - (area.address + area.length);
+            area.length = end - area.address;
+        }
+        else
+        {
+            areas.push_back({write.address, areaSize, write.length});
+            areaSize += write.length;
+        }
+    }
+
+    // the writes are copied in their order, so that the last one wins
+    std::vector<char> data(areaSize);
+    for(const auto &write : m_writes)
+    {
+        auto area = std::upper_bound(areas.begin(), areas.end(), write.address,
+            [](Address address, const Write &a){ return address < a.address; }) - 1;
+
+        std::copy_n(m_data.data() + write.offset, write.length, data.data() + area->offset + (write.address - area->address));
+    }
+
+    std::vector<WriteRequest> requests;
+    for(const auto &area : areas)
+        requests.push_back({area.address, data.data() + area.offset, area.length});
+
+    m_writes.clear();
+    m_data.clear();
+    m_writtenAreaCount = areas.size();
+
+    auto throwError = [this](const char *message, Address address)
+    {
+        std::cout << "Failure!" << std::endl;
+
+        std::ostringstream os;
+        os << message << " \"" << m_process.getCurrentModuleName() << "\" (at " << std::showbase << std::hex << address << ").";
+        throw std::runtime_error(os.str());
+    };
+
+    if(!m_process.writeBatch(requests.data(), requests.size()))
+    {
+        for(const auto &request : requests)
+            if(!request.success)
+                throwError("Failed to write memory into process", request.address);
+    }
+
+    // everything is read back at once
+    std::vector<char> readData(areaSize);
+    std::vector<ReadRequest> readRequests;
+    for(const auto &area : areas)
+        readRequests.push_back({area.address, readData.data() + area.offset, area.length});
+
+    m_process.readBatch(readRequests.data(), readRequests.size());
+
+    for(std::size_t i = 0; i < areas.size(); ++i)
+    {
+        const auto &area = areas[i];
+        if(!readRequests[i].success || !std::equal(readData.begin() + area.offset,
+            readData.begin() + area.offset + area.length, data.begin() + area.offset))
+                throwError("Failed to verify memory written into process", area.address);
+    }
+}
+
+std::size_t WriteTransaction::getWrittenAreaCount() const noexcept
+{
+    return m_writtenAreaCount;
+}
@@ -0,0 +1,54 @@
+#ifndef WRITETRANSACTION_H
+#define WRITETRANSACTION_H
+
+#include "Process.hpp"
+
+// Collects writes into the process memory and applies them at once.
+// The adjacent and overlapping writes are merged (the last write wins), so
+// that the game sees as few partial updates as possible. The written areas
+// are read back afterwards to verify them.
+class WriteTransaction
+{
+    public:
+        WriteTransaction(Process &process);
+
+        void write(Address address, const char *data, std::size_t length);
+
+        template<typename T> void writeValue(Address address, T value, Endianness endianness)
+        {
+            std::array<char, sizeof(T)> data;
+            encodeValue(value, endianness, data.data());
+            write(address, data.data(), data.size());
+        }
+
+        // writes a field of the structure located at 'structure', see 'ChallengeLayout'
+        template<typename F> void writeField(Address structure, typename F::Type value)
+        {
+            writeValue(structure + F::offset, value, F::endianness);
+        }
+
+        // applies and verifies the writes, then clears the transaction
+        // throws std::runtime_error if a write fails or can't be verified
+        void commit();
+
+        // returns the number of areas written by the last commit
+        std::size_t getWrittenAreaCount() const noexcept;
+
+    private:
+        struct Write
+        {
+            Address address;
+            std::size_t offset;
+            std::size_t length;
+        };
+
+        Process &m_process;
+
+        // in the order they were requested, their data being stored in 'm_data'
+        std::vector<Write> m_writes;
+        std::vector<char> m_data;
+
+        std::size_t m_writtenAreaCount {0};
+};
+
+#endif // WRITETRANSACTION_H